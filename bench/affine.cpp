@@ -0,0 +1,98 @@
+// Batch conversion of mappings adding a constant, a 16-bit offset and a
+// 32-bit identity, with each kernel against one call per value.
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark.h"
+#include "lguim/secureenumconverter.h"
+
+enum class Port : std::uint16_t {
+    P00, P01, P02, P03, P04, P05, P06, P07,
+    P08, P09, P10, P11, P12, P13, P14, P15,
+};
+
+enum class WirePort : std::uint16_t {
+    W00 = 0x1f40, W01, W02, W03, W04, W05, W06, W07,
+    W08, W09, W10, W11, W12, W13, W14, W15,
+};
+
+using Offset = lguim::SecureEnumConverter<Port, WirePort>;
+
+#define SEC_TYPE Offset
+#define SEC_INLINE
+#define SEC_MAPPING \
+    SEC_EQUIV(Port::P00, WirePort::W00) SEC_EQUIV(Port::P01, WirePort::W01) \
+    SEC_EQUIV(Port::P02, WirePort::W02) SEC_EQUIV(Port::P03, WirePort::W03) \
+    SEC_EQUIV(Port::P04, WirePort::W04) SEC_EQUIV(Port::P05, WirePort::W05) \
+    SEC_EQUIV(Port::P06, WirePort::W06) SEC_EQUIV(Port::P07, WirePort::W07) \
+    SEC_EQUIV(Port::P08, WirePort::W08) SEC_EQUIV(Port::P09, WirePort::W09) \
+    SEC_EQUIV(Port::P10, WirePort::W10) SEC_EQUIV(Port::P11, WirePort::W11) \
+    SEC_EQUIV(Port::P12, WirePort::W12) SEC_EQUIV(Port::P13, WirePort::W13) \
+    SEC_EQUIV(Port::P14, WirePort::W14) SEC_EQUIV(Port::P15, WirePort::W15)
+#include "lguim/secureenumconverter.inc"
+
+enum class Color : std::uint32_t { Red, Green, Blue, Alpha };
+enum class WireColor : std::uint32_t { Red, Green, Blue, Alpha };
+
+using Identity = lguim::SecureEnumConverter<Color, WireColor>;
+
+#define SEC_TYPE Identity
+#define SEC_INLINE
+#define SEC_MAPPING \
+    SEC_EQUIV(Color::Red, WireColor::Red) \
+    SEC_EQUIV(Color::Green, WireColor::Green) \
+    SEC_EQUIV(Color::Blue, WireColor::Blue) \
+    SEC_EQUIV(Color::Alpha, WireColor::Alpha)
+#include "lguim/secureenumconverter.inc"
+
+using lguim::priv::Isa;
+
+template <typename SUT>
+void benchConverter(const char* title) {
+    using Internal = typename SUT::Internal;
+    using External = typename SUT::External;
+    using Batch = lguim::priv::SimdBatch<
+        lguim::priv::EngineConverter<lguim::engine::Auto, true, SUT>,
+        true, SUT>;
+
+    const std::vector<Internal> values(
+        SUT::convertibleInternalSpan().begin(),
+        SUT::convertibleInternalSpan().end());
+    const auto inputs = benchRandomInputs(values, 1 << 22);
+    std::vector<External> outputs(inputs.size());
+
+    std::cout << title << ", random inputs" << std::endl;
+
+    benchRun("One toExternalOpt per value", inputs.size(), 10, [&] {
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            const auto external = SUT::toExternalOpt(inputs[i]);
+            if (external) {
+                outputs[i] = *external;
+            }
+        }
+        benchDoNotOptimize(outputs.data());
+    });
+
+    const struct { Isa isa; const char* name; } kernels[] = {
+        { Isa::Scalar, "Batch, scalar" },
+        { Isa::Sse42, "Batch, SSE4.2" },
+        { Isa::Avx2, "Batch, AVX2" },
+    };
+
+    for (const auto& kernel : kernels) {
+        if (kernel.isa > lguim::priv::detectIsa()) {
+            continue;
+        }
+        benchRun(kernel.name, inputs.size(), 10, [&] {
+            const auto result = Batch::convertWith(
+                kernel.isa, inputs.data(), inputs.size(), outputs.data());
+            benchDoNotOptimize(result.invalidCount);
+        });
+    }
+}
+
+int main() {
+    benchConverter<Offset>("16-bit offset to external");
+    benchConverter<Identity>("32-bit identity to external");
+}
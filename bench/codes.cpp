@@ -0,0 +1,137 @@
+// Decoding of big-endian 16-bit codes from packets: copying, swapping,
+// casting and calling `toInternalOrThrow` for each field, against
+// `decodeCodes` on the fields in place and on contiguous codes. The codes
+// span 1025 values, one too many for the gather kernel; the same codes
+// without the last one are decoded with it.
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "benchmark.h"
+#include "lguim/enumcodes.h"
+
+enum class Op : std::uint8_t {
+    O00, O01, O02, O03, O04, O05, O06, O07, O08, O09, O10, O11,
+};
+
+enum class WireOp : std::uint16_t {
+    W00 = 0x0100, W01 = 0x0101, W02 = 0x0102, W03 = 0x0103, W04 = 0x0200,
+    W05 = 0x0201, W06 = 0x0202, W07 = 0x0300, W08 = 0x0301, W09 = 0x0400,
+    W10 = 0x0401, W11 = 0x0500,
+};
+
+using SUT = lguim::SecureEnumConverter<Op, WireOp>;
+
+#define SEC_TYPE SUT
+#define SEC_INLINE
+#define SEC_MAPPING                                                   \
+    SEC_EQUIV(Op::O00, WireOp::W00) SEC_EQUIV(Op::O01, WireOp::W01)   \
+    SEC_EQUIV(Op::O02, WireOp::W02) SEC_EQUIV(Op::O03, WireOp::W03)   \
+    SEC_EQUIV(Op::O04, WireOp::W04) SEC_EQUIV(Op::O05, WireOp::W05)   \
+    SEC_EQUIV(Op::O06, WireOp::W06) SEC_EQUIV(Op::O07, WireOp::W07)   \
+    SEC_EQUIV(Op::O08, WireOp::W08) SEC_EQUIV(Op::O09, WireOp::W09)   \
+    SEC_EQUIV(Op::O10, WireOp::W10) SEC_EQUIV(Op::O11, WireOp::W11)
+#include "lguim/secureenumconverter.inc"
+
+using Gathered = lguim::SecureEnumConverter<Op, WireOp, struct GatheredTag>;
+
+#define SEC_TYPE Gathered
+#define SEC_INLINE
+#define SEC_MAPPING                                                   \
+    SEC_EQUIV(Op::O00, WireOp::W00) SEC_EQUIV(Op::O01, WireOp::W01)   \
+    SEC_EQUIV(Op::O02, WireOp::W02) SEC_EQUIV(Op::O03, WireOp::W03)   \
+    SEC_EQUIV(Op::O04, WireOp::W04) SEC_EQUIV(Op::O05, WireOp::W05)   \
+    SEC_EQUIV(Op::O06, WireOp::W06) SEC_EQUIV(Op::O07, WireOp::W07)   \
+    SEC_EQUIV(Op::O08, WireOp::W08) SEC_EQUIV(Op::O09, WireOp::W09)   \
+    SEC_EQUIV(Op::O10, WireOp::W10)                                   \
+    SEC_ORPHAN_INT(Op::O11) SEC_ORPHAN_EXT(WireOp::W11)
+#include "lguim/secureenumconverter.inc"
+
+// Big-endian 16-bit codes, in packets and contiguous
+struct Buffers {
+    std::vector<unsigned char> packets;
+    std::vector<unsigned char> contiguous;
+};
+
+Buffers codeBuffers(
+    const std::vector<WireOp>& codes, std::size_t packetSize,
+    std::size_t offset) {
+    Buffers buffers{
+        std::vector<unsigned char>(codes.size() * packetSize, 0xee),
+        std::vector<unsigned char>(codes.size() * 2),
+    };
+    for (std::size_t i = 0; i < codes.size(); ++i) {
+        const auto code = static_cast<std::uint16_t>(codes[i]);
+        unsigned char* field = &buffers.packets[i * packetSize + offset];
+        field[0] = buffers.contiguous[2 * i] =
+            static_cast<unsigned char>(code >> 8);
+        field[1] = buffers.contiguous[2 * i + 1] =
+            static_cast<unsigned char>(code & 0xff);
+    }
+    return buffers;
+}
+
+int main() {
+    constexpr std::size_t packetSize = 12;
+    constexpr std::size_t offset = 2;
+
+    const std::vector<WireOp> ops(
+        SUT::convertibleExternalSpan().begin(),
+        SUT::convertibleExternalSpan().end());
+    const std::size_t count = std::size_t{1} << 22;
+    const std::vector<WireOp> codes = benchRandomInputs(ops, count);
+
+    const Buffers buffers = codeBuffers(codes, packetSize, offset);
+    const std::vector<unsigned char>& packets = buffers.packets;
+    const std::vector<unsigned char>& contiguous = buffers.contiguous;
+
+    std::vector<Op> outputs(count);
+    std::vector<std::uint8_t> validity((count + 7) / 8);
+
+    benchRun("copy + bswap + toInternalOrThrow", count, 10, [&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::uint16_t code;
+            std::memcpy(&code, &packets[i * packetSize + offset], 2);
+            outputs[i] = SUT::toInternalOrThrow(
+                static_cast<WireOp>(__builtin_bswap16(code)));
+        }
+        benchDoNotOptimize(outputs[count - 1]);
+    });
+
+    benchRun("decodeCodes, fields of packets", count, 10, [&] {
+        const lguim::BatchResult result = lguim::decodeCodes<SUT>(
+            packets.data() + offset,
+            {2, lguim::ByteOrder::Big, packetSize}, count, outputs.data(),
+            validity.data());
+        benchDoNotOptimize(result.invalidCount);
+    });
+
+    benchRun("decodeCodes, contiguous codes", count, 10, [&] {
+        const lguim::BatchResult result = lguim::decodeCodes<SUT>(
+            contiguous.data(), {2, lguim::ByteOrder::Big, 2}, count,
+            outputs.data(), validity.data());
+        benchDoNotOptimize(result.invalidCount);
+    });
+
+    const std::vector<WireOp> gatheredOps(
+        Gathered::convertibleExternalSpan().begin(),
+        Gathered::convertibleExternalSpan().end());
+    const Buffers gathered = codeBuffers(
+        benchRandomInputs(gatheredOps, count), packetSize, offset);
+
+    benchRun("decodeCodes, fields of packets, gather", count, 10, [&] {
+        const lguim::BatchResult result = lguim::decodeCodes<Gathered>(
+            gathered.packets.data() + offset,
+            {2, lguim::ByteOrder::Big, packetSize}, count, outputs.data(),
+            validity.data());
+        benchDoNotOptimize(result.invalidCount);
+    });
+
+    benchRun("decodeCodes, contiguous codes, gather", count, 10, [&] {
+        const lguim::BatchResult result = lguim::decodeCodes<Gathered>(
+            gathered.contiguous.data(), {2, lguim::ByteOrder::Big, 2}, count,
+            outputs.data(), validity.data());
+        benchDoNotOptimize(result.invalidCount);
+    });
+}
@@ -0,0 +1,52 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Keeps the compiler from optimizing away a computed value.
+template <typename T>
+inline void benchDoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Random picks among `values`, always the same for a given seed.
+template <typename T>
+std::vector<T> benchRandomInputs(
+    const std::vector<T>& values, std::size_t count, unsigned seed = 42) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<std::size_t> pick(0, values.size() - 1);
+
+    std::vector<T> inputs;
+    inputs.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        inputs.push_back(values[pick(generator)]);
+    }
+    return inputs;
+}
+
+// Runs `body` (processing `items` items per call) `rounds` times and prints
+// the best time per item.
+template <typename Body>
+void benchRun(
+    const char* name, std::size_t items, std::size_t rounds, Body body) {
+    double best = 0;
+
+    for (std::size_t round = 0; round < rounds; ++round) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double nsPerItem =
+            std::chrono::duration<double, std::nano>(stop - start).count()
+                / static_cast<double>(items);
+        if (round == 0 || nsPerItem < best) {
+            best = nsPerItem;
+        }
+    }
+
+    std::cout << std::left << std::setw(40) << name
+        << std::right << std::setw(10) << std::fixed << std::setprecision(3)
+        << best << " ns/item" << std::endl;
+}
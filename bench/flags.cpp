@@ -0,0 +1,90 @@
+// Conversion of sets of flags: a loop over the bits calling
+// `toExternalOpt`, against `convertFlags` with its per-byte tables, and the
+// `pext`/`pdep` kernel when the CPU has BMI2.
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark.h"
+#include "lguim/enumflags.h"
+
+enum class Perm : std::uint32_t {
+    P00 = 1u << 0, P01 = 1u << 1, P02 = 1u << 2, P03 = 1u << 3,
+    P04 = 1u << 4, P05 = 1u << 5, P06 = 1u << 6, P07 = 1u << 7,
+    P08 = 1u << 8, P09 = 1u << 9, P10 = 1u << 10, P11 = 1u << 11,
+    P12 = 1u << 12, P13 = 1u << 13, P14 = 1u << 14, P15 = 1u << 15,
+};
+
+enum class Wire : std::uint32_t {
+    W00 = 1u << 0, W01 = 1u << 3, W02 = 1u << 4, W03 = 1u << 7,
+    W04 = 1u << 9, W05 = 1u << 10, W06 = 1u << 12, W07 = 1u << 15,
+    W08 = 1u << 16, W09 = 1u << 19, W10 = 1u << 21, W11 = 1u << 22,
+    W12 = 1u << 24, W13 = 1u << 27, W14 = 1u << 28, W15 = 1u << 31,
+};
+
+using SUT = lguim::SecureEnumConverter<Perm, Wire>;
+
+#define SEC_TYPE SUT
+#define SEC_INLINE
+#define SEC_MAPPING \
+    SEC_EQUIV(Perm::P00, Wire::W00) SEC_EQUIV(Perm::P01, Wire::W01) \
+    SEC_EQUIV(Perm::P02, Wire::W02) SEC_EQUIV(Perm::P03, Wire::W03) \
+    SEC_EQUIV(Perm::P04, Wire::W04) SEC_EQUIV(Perm::P05, Wire::W05) \
+    SEC_EQUIV(Perm::P06, Wire::W06) SEC_EQUIV(Perm::P07, Wire::W07) \
+    SEC_EQUIV(Perm::P08, Wire::W08) SEC_EQUIV(Perm::P09, Wire::W09) \
+    SEC_EQUIV(Perm::P10, Wire::W10) SEC_EQUIV(Perm::P11, Wire::W11) \
+    SEC_EQUIV(Perm::P12, Wire::W12) SEC_EQUIV(Perm::P13, Wire::W13) \
+    SEC_EQUIV(Perm::P14, Wire::W14) SEC_EQUIV(Perm::P15, Wire::W15)
+#include "lguim/secureenumconverter.inc"
+
+int main() {
+    std::vector<std::uint32_t> masks;
+    for (std::uint32_t i = 0; i < 1024; ++i) {
+        masks.push_back(i * 2654435761u >> 16);
+    }
+
+    const std::size_t count = std::size_t{1} << 22;
+    const std::vector<std::uint32_t> inputs =
+        benchRandomInputs(masks, count);
+
+    benchRun("loop over bits + toExternalOpt", count, 5, [&] {
+        std::uint32_t all = 0;
+        for (std::uint32_t bits : inputs) {
+            std::uint32_t result = 0;
+            for (std::uint32_t rest = bits; rest != 0; rest &= rest - 1) {
+                const auto converted = SUT::toExternalOpt(
+                    static_cast<Perm>(rest & (~rest + 1)));
+                if (converted) {
+                    result |= static_cast<std::uint32_t>(*converted);
+                }
+            }
+            all ^= result;
+        }
+        benchDoNotOptimize(all);
+    });
+
+    benchRun("convertFlags", count, 5, [&] {
+        std::uint32_t all = 0;
+        for (std::uint32_t bits : inputs) {
+            all ^= static_cast<std::uint32_t>(
+                lguim::convertFlags<SUT, lguim::side::External>(
+                    static_cast<Perm>(bits)).flags);
+        }
+        benchDoNotOptimize(all);
+    });
+
+#if LGUIM_SEC_SIMD_X86
+    using Kernels = lguim::priv::FlagKernels<
+        lguim::priv::FlagSource<SUT, lguim::side::External>>;
+
+    if (__builtin_cpu_supports("bmi2")) {
+        benchRun("pext + pdep", count, 5, [&] {
+            std::uint32_t all = 0;
+            for (std::uint32_t bits : inputs) {
+                all ^= Kernels::pext(bits);
+            }
+            benchDoNotOptimize(all);
+        });
+    }
+#endif
+}
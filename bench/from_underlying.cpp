@@ -0,0 +1,87 @@
+// Decoding of untrusted bytes, half of which are not valid codes: casting
+// to the enumeration and converting with the `Switch` engine, against
+// `fromUnderlying` and `fromUnderlyingBatch`, which check and convert with
+// one lookup without branch.
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark.h"
+#include "lguim/secureenumconverter.h"
+
+enum class Op : std::uint8_t {
+    O00, O01, O02, O03, O04, O05, O06, O07, O08, O09, O10, O11,
+    O12, O13, O14, O15,
+};
+
+enum class WireOp : std::uint8_t {
+    W00 = 0x01, W01 = 0x02, W02 = 0x05, W03 = 0x09, W04 = 0x10, W05 = 0x11,
+    W06 = 0x20, W07 = 0x28, W08 = 0x30, W09 = 0x41, W10 = 0x42, W11 = 0x50,
+    W12 = 0x60, W13 = 0x7f, W14 = 0x80, W15 = 0xc0, W16 = 0xfe,
+};
+
+#define BENCH_MAPPING                                                     \
+    SEC_EQUIV(Op::O00, WireOp::W00) SEC_EQUIV(Op::O01, WireOp::W01)       \
+    SEC_EQUIV(Op::O02, WireOp::W02) SEC_EQUIV(Op::O03, WireOp::W03)       \
+    SEC_EQUIV(Op::O04, WireOp::W04) SEC_EQUIV(Op::O05, WireOp::W05)       \
+    SEC_EQUIV(Op::O06, WireOp::W06) SEC_EQUIV(Op::O07, WireOp::W07)       \
+    SEC_EQUIV(Op::O08, WireOp::W08) SEC_EQUIV(Op::O09, WireOp::W09)       \
+    SEC_EQUIV(Op::O10, WireOp::W10) SEC_EQUIV(Op::O11, WireOp::W11)       \
+    SEC_EQUIV(Op::O12, WireOp::W12) SEC_EQUIV(Op::O13, WireOp::W13)       \
+    SEC_EQUIV(Op::O14, WireOp::W14) SEC_EQUIV(Op::O15, WireOp::W15)       \
+    SEC_ORPHAN_EXT(WireOp::W16)
+
+using SUT = lguim::SecureEnumConverter<Op, WireOp>;
+using SwitchSUT = lguim::SecureEnumConverter<Op, WireOp, struct SwitchTag>;
+
+#define SEC_TYPE SUT
+#define SEC_INLINE
+#define SEC_MAPPING BENCH_MAPPING
+#include "lguim/secureenumconverter.inc"
+
+#define SEC_TYPE SwitchSUT
+#define SEC_INLINE
+#define SEC_ENGINE lguim::engine::Switch
+#define SEC_MAPPING BENCH_MAPPING
+#include "lguim/secureenumconverter.inc"
+
+int main() {
+    std::vector<std::uint8_t> bytes;
+    for (unsigned byte = 0; byte < 256; ++byte) {
+        bytes.push_back(static_cast<std::uint8_t>(byte));
+    }
+    for (WireOp op : SUT::convertibleExternalSpan()) {
+        for (int copy = 0; copy < 16; ++copy) {
+            bytes.push_back(static_cast<std::uint8_t>(op));
+        }
+    }
+
+    const std::size_t count = std::size_t{1} << 22;
+    const std::vector<std::uint8_t> inputs =
+        benchRandomInputs(bytes, count);
+    std::vector<Op> outputs(count);
+
+    benchRun("cast + Switch toInternalOpt", count, 10, [&] {
+        unsigned converted = 0;
+        for (std::uint8_t raw : inputs) {
+            const auto op = SwitchSUT::toInternalOpt(static_cast<WireOp>(raw));
+            converted += op ? static_cast<unsigned>(*op) : 1000;
+        }
+        benchDoNotOptimize(converted);
+    });
+
+    benchRun("fromUnderlying", count, 10, [&] {
+        unsigned converted = 0;
+        for (std::uint8_t raw : inputs) {
+            const auto op = SUT::fromUnderlying(raw);
+            converted += op ? static_cast<unsigned>(*op) : 1000;
+        }
+        benchDoNotOptimize(converted);
+    });
+
+    benchRun("fromUnderlyingBatch", count, 10, [&] {
+        const lguim::BatchResult result =
+            SUT::fromUnderlyingBatch(inputs.data(), count, outputs.data());
+        benchDoNotOptimize(result.invalidCount);
+    });
+}
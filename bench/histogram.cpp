@@ -0,0 +1,77 @@
+// Grouping of records by the external value of their status: counting in a
+// `std::map` after `toExternalOrThrow`, against `conversionHistogram` and
+// `partitionByConversion`, on random statuses and on long runs of one.
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "benchmark.h"
+#include "lguim/enumhistogram.h"
+
+enum class Phase : std::uint8_t {
+    P00, P01, P02, P03, P04, P05, P06, P07,
+    P08, P09, P10, P11, P12, P13, P14, P15,
+};
+
+enum class Code : std::uint32_t {
+    C00 = 0x100, C01 = 0x101, C02 = 0x102, C03 = 0x103,
+    C04 = 0x110, C05 = 0x111, C06 = 0x112, C07 = 0x113,
+    C08 = 0x120, C09 = 0x121, C10 = 0x122, C11 = 0x123,
+    C12 = 0x130, C13 = 0x131, C14 = 0x132, C15 = 0x133,
+};
+
+using SUT = lguim::SecureEnumConverter<Phase, Code>;
+
+#define SEC_TYPE SUT
+#define SEC_INLINE
+#define SEC_MAPPING \
+    SEC_EQUIV(Phase::P00, Code::C00) SEC_EQUIV(Phase::P01, Code::C01) \
+    SEC_EQUIV(Phase::P02, Code::C02) SEC_EQUIV(Phase::P03, Code::C03) \
+    SEC_EQUIV(Phase::P04, Code::C04) SEC_EQUIV(Phase::P05, Code::C05) \
+    SEC_EQUIV(Phase::P06, Code::C06) SEC_EQUIV(Phase::P07, Code::C07) \
+    SEC_EQUIV(Phase::P08, Code::C08) SEC_EQUIV(Phase::P09, Code::C09) \
+    SEC_EQUIV(Phase::P10, Code::C10) SEC_EQUIV(Phase::P11, Code::C11) \
+    SEC_EQUIV(Phase::P12, Code::C12) SEC_EQUIV(Phase::P13, Code::C13) \
+    SEC_PROJ_I2E(Phase::P14, Code::C13) SEC_EQUIV(Phase::P15, Code::C15) \
+    SEC_ORPHAN_EXT(Code::C14)
+#include "lguim/secureenumconverter.inc"
+
+void benchInputs(const char* title, const std::vector<Phase>& inputs) {
+    std::cout << title << std::endl;
+
+    benchRun("std::map + toExternalOrThrow", inputs.size(), 5, [&] {
+        std::map<Code, std::size_t> counts;
+        for (Phase phase : inputs) {
+            ++counts[SUT::toExternalOrThrow(phase)];
+        }
+        benchDoNotOptimize(counts.size());
+    });
+
+    benchRun("conversionHistogram", inputs.size(), 5, [&] {
+        const auto histogram =
+            lguim::conversionHistogram<SUT, lguim::side::External>(
+                inputs.data(), inputs.size());
+        benchDoNotOptimize(histogram.counts[Code::C00]);
+    });
+
+    std::vector<std::size_t> indexes(inputs.size());
+    benchRun("partitionByConversion", inputs.size(), 5, [&] {
+        const auto partition =
+            lguim::partitionByConversion<SUT, lguim::side::External>(
+                inputs.data(), inputs.size(), indexes.data());
+        benchDoNotOptimize(partition.offsets[0]);
+        benchDoNotOptimize(indexes[0]);
+    });
+}
+
+int main() {
+    std::vector<Phase> phases;
+    for (unsigned i = 0; i < 16; ++i) {
+        phases.push_back(static_cast<Phase>(i));
+    }
+
+    const std::size_t count = std::size_t{1} << 22;
+    benchInputs("Random phases", benchRandomInputs(phases, count));
+    benchInputs("One phase", std::vector<Phase>(count, Phase::P03));
+}
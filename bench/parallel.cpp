@@ -0,0 +1,79 @@
+// Conversion of a large array with `parallelConvertBatch`, from one thread
+// to the number of hardware threads.
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+#include "lguim/parallelconversion.h"
+
+enum class Phase : std::uint16_t {
+    P00, P01, P02, P03, P04, P05, P06, P07,
+    P08, P09, P10, P11, P12, P13, P14, P15,
+};
+
+enum class Code : std::uint32_t {
+    C00 = 0x100, C01 = 0x101, C02 = 0x102, C03 = 0x103,
+    C04 = 0x110, C05 = 0x111, C06 = 0x112, C07 = 0x113,
+    C08 = 0x120, C09 = 0x121, C10 = 0x122, C11 = 0x123,
+    C12 = 0x130, C13 = 0x131, C14 = 0x132, C15 = 0x133,
+};
+
+using SUT = lguim::SecureEnumConverter<Phase, Code>;
+
+#define SEC_TYPE SUT
+#define SEC_INLINE
+#define SEC_MAPPING \
+    SEC_EQUIV(Phase::P00, Code::C00) SEC_EQUIV(Phase::P01, Code::C01) \
+    SEC_EQUIV(Phase::P02, Code::C02) SEC_EQUIV(Phase::P03, Code::C03) \
+    SEC_EQUIV(Phase::P04, Code::C04) SEC_EQUIV(Phase::P05, Code::C05) \
+    SEC_EQUIV(Phase::P06, Code::C06) SEC_EQUIV(Phase::P07, Code::C07) \
+    SEC_EQUIV(Phase::P08, Code::C08) SEC_EQUIV(Phase::P09, Code::C09) \
+    SEC_EQUIV(Phase::P10, Code::C10) SEC_EQUIV(Phase::P11, Code::C11) \
+    SEC_EQUIV(Phase::P12, Code::C12) SEC_EQUIV(Phase::P13, Code::C13) \
+    SEC_EQUIV(Phase::P14, Code::C14) SEC_ORPHAN_INT(Phase::P15) \
+    SEC_ORPHAN_EXT(Code::C15)
+#include "lguim/secureenumconverter.inc"
+
+int main() {
+    std::vector<Phase> phases;
+    for (unsigned i = 0; i < 16; ++i) {
+        phases.push_back(static_cast<Phase>(i));
+    }
+    const auto inputs = benchRandomInputs(phases, std::size_t{1} << 26);
+    std::vector<Code> outputs(inputs.size());
+
+    const std::size_t hardware =
+        std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "Parallel conversion of 64M values to external, "
+        << hardware << " hardware threads" << std::endl;
+
+    benchRun("toExternalBatch", inputs.size(), 5, [&] {
+        const auto result = SUT::toExternalBatch(
+            inputs.data(), inputs.size(), outputs.data());
+        benchDoNotOptimize(result.invalidCount);
+    });
+
+    // Powers of two, then all the hardware threads
+    std::vector<std::size_t> threadCounts;
+    for (std::size_t threads = 1; threads < hardware; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardware);
+
+    for (std::size_t threads : threadCounts) {
+        const std::string name =
+            "parallelConvertBatch, " + std::to_string(threads) + " threads";
+
+        benchRun(name.c_str(), inputs.size(), 5, [&] {
+            const auto result = lguim::parallelConvertBatch<
+                SUT, lguim::side::External>(
+                    inputs.data(), inputs.size(), outputs.data(),
+                    lguim::ParallelOptions(threads));
+            benchDoNotOptimize(result.invalidCount);
+        });
+    }
+}
@@ -0,0 +1,109 @@
+// Batch conversion of a small 8-bit enumeration with each kernel, against
+// one call per value, and validation of the same values.
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark.h"
+#include "lguim/secureenumconverter.h"
+
+enum class Level : std::uint8_t {
+    L00, L01, L02, L03, L04, L05, L06, L07,
+    L08, L09, L10, L11, L12, L13, L14, L15,
+};
+
+enum class Wire : std::uint8_t {
+    W00 = 0x40, W01, W02, W03, W04, W05, W06, W07,
+    W08, W09, W10, W11, W12, W13, W14, W15,
+};
+
+using SUT = lguim::SecureEnumConverter<Level, Wire>;
+
+#define SEC_TYPE SUT
+#define SEC_INLINE
+#define SEC_MAPPING \
+    SEC_EQUIV(Level::L00, Wire::W03) SEC_EQUIV(Level::L01, Wire::W00) \
+    SEC_EQUIV(Level::L02, Wire::W01) SEC_EQUIV(Level::L03, Wire::W02) \
+    SEC_EQUIV(Level::L04, Wire::W07) SEC_EQUIV(Level::L05, Wire::W04) \
+    SEC_EQUIV(Level::L06, Wire::W05) SEC_EQUIV(Level::L07, Wire::W06) \
+    SEC_EQUIV(Level::L08, Wire::W11) SEC_EQUIV(Level::L09, Wire::W08) \
+    SEC_EQUIV(Level::L10, Wire::W09) SEC_EQUIV(Level::L11, Wire::W10) \
+    SEC_EQUIV(Level::L12, Wire::W15) SEC_EQUIV(Level::L13, Wire::W12) \
+    SEC_EQUIV(Level::L14, Wire::W13) SEC_ORPHAN_INT(Level::L15) \
+    SEC_ORPHAN_EXT(Wire::W14)
+#include "lguim/secureenumconverter.inc"
+
+using Batch = lguim::priv::SimdBatch<
+    lguim::priv::EngineConverter<lguim::engine::Auto, true, SUT>, true, SUT>;
+using lguim::priv::Isa;
+
+int main() {
+    std::vector<Level> levels;
+    for (unsigned i = 0; i < 16; ++i) {
+        levels.push_back(static_cast<Level>(i));
+    }
+    const auto inputs = benchRandomInputs(levels, 1 << 22);
+    std::vector<Wire> outputs(inputs.size());
+
+    std::cout << "Small 8-bit enumeration to external, random inputs"
+        << std::endl;
+
+    benchRun("One toExternalOpt per value", inputs.size(), 10, [&] {
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            const auto wire = SUT::toExternalOpt(inputs[i]);
+            if (wire) {
+                outputs[i] = *wire;
+            }
+        }
+        benchDoNotOptimize(outputs.data());
+    });
+
+    const struct { Isa isa; const char* name; } kernels[] = {
+        { Isa::Scalar, "Batch, scalar" },
+        { Isa::Sse42, "Batch, SSE4.2" },
+        { Isa::Avx2, "Batch, AVX2" },
+        { Isa::Avx512Vbmi, "Batch, AVX-512 VBMI" },
+    };
+
+    for (const auto& kernel : kernels) {
+        if (kernel.isa > lguim::priv::detectIsa()) {
+            continue;
+        }
+        benchRun(kernel.name, inputs.size(), 10, [&] {
+            const auto result = Batch::convertWith(
+                kernel.isa, inputs.data(), inputs.size(), outputs.data());
+            benchDoNotOptimize(result.invalidCount);
+        });
+    }
+
+    // Only valid values, so that the whole array is scanned
+    std::vector<Level> valid(inputs.size(), Level::L03);
+    for (std::size_t i = 0; i < valid.size(); ++i) {
+        if (inputs[i] != Level::L15) {
+            valid[i] = inputs[i];
+        }
+    }
+
+    std::cout << "Validation of the same values" << std::endl;
+
+    benchRun("convertibleInternalValues().count", valid.size(), 10, [&] {
+        std::size_t found = 0;
+        for (Level level : valid) {
+            found += SUT::convertibleInternalValues().count(level);
+        }
+        benchDoNotOptimize(found);
+    });
+
+    benchRun("isConvertibleInternal", valid.size(), 10, [&] {
+        std::size_t found = 0;
+        for (Level level : valid) {
+            found += SUT::isConvertibleInternal(level) ? 1 : 0;
+        }
+        benchDoNotOptimize(found);
+    });
+
+    benchRun("firstInvalidInternal", valid.size(), 10, [&] {
+        benchDoNotOptimize(
+            SUT::firstInvalidInternal(valid.data(), valid.size()));
+    });
+}
@@ -0,0 +1,80 @@
+// Conversion of sparse enumerations (vendor protocol codes) with the
+// `Switch` and `SortedKeys` engines. The codes are too far apart for the
+// `DenseTable` engine.
+
+#include <cstdint>
+#include <vector>
+
+#include "benchmark.h"
+#include "lguim/secureenumconverter.h"
+
+enum class Code : std::int32_t {
+    C00 = 0x0001, C01 = 0x0002, C02 = 0x0004, C03 = 0x0010,
+    C04 = 0x0020, C05 = 0x0080, C06 = 0x0100, C07 = 0x0400,
+    C08 = 0x0800, C09 = 0x1000, C10 = 0x2000, C11 = 0x4000,
+    C12 = 0x8000, C13 = 0x9001, C14 = 0xA000, C15 = 0xC000,
+    C16 = 100000, C17 = 100001, C18 = 120000, C19 = 250000,
+    C20 = 300000, C21 = 400000, C22 = 500000, C23 = 600000,
+};
+
+enum class Status : std::uint8_t {
+    S00, S01, S02, S03, S04, S05, S06, S07, S08, S09, S10, S11,
+    S12, S13, S14, S15, S16, S17, S18, S19, S20, S21, S22, S23,
+};
+
+#define BENCH_MAPPING                                                \
+    SEC_EQUIV(Status::S00, Code::C00) SEC_EQUIV(Status::S01, Code::C01) \
+    SEC_EQUIV(Status::S02, Code::C02) SEC_EQUIV(Status::S03, Code::C03) \
+    SEC_EQUIV(Status::S04, Code::C04) SEC_EQUIV(Status::S05, Code::C05) \
+    SEC_EQUIV(Status::S06, Code::C06) SEC_EQUIV(Status::S07, Code::C07) \
+    SEC_EQUIV(Status::S08, Code::C08) SEC_EQUIV(Status::S09, Code::C09) \
+    SEC_EQUIV(Status::S10, Code::C10) SEC_EQUIV(Status::S11, Code::C11) \
+    SEC_EQUIV(Status::S12, Code::C12) SEC_EQUIV(Status::S13, Code::C13) \
+    SEC_EQUIV(Status::S14, Code::C14) SEC_EQUIV(Status::S15, Code::C15) \
+    SEC_EQUIV(Status::S16, Code::C16) SEC_EQUIV(Status::S17, Code::C17) \
+    SEC_EQUIV(Status::S18, Code::C18) SEC_EQUIV(Status::S19, Code::C19) \
+    SEC_EQUIV(Status::S20, Code::C20) SEC_EQUIV(Status::S21, Code::C21) \
+    SEC_ORPHAN_INT(Status::S22) SEC_ORPHAN_INT(Status::S23)           \
+    SEC_ORPHAN_EXT(Code::C22) SEC_ORPHAN_EXT(Code::C23)
+
+using SwitchSUT = lguim::SecureEnumConverter<Status, Code, struct SwitchTag>;
+using SortedSUT = lguim::SecureEnumConverter<Status, Code, struct SortedTag>;
+
+#define SEC_TYPE SwitchSUT
+#define SEC_INLINE
+#define SEC_ENGINE lguim::engine::Switch
+#define SEC_MAPPING BENCH_MAPPING
+#include "lguim/secureenumconverter.inc"
+
+#define SEC_TYPE SortedSUT
+#define SEC_INLINE
+#define SEC_ENGINE lguim::engine::SortedKeys
+#define SEC_MAPPING BENCH_MAPPING
+#include "lguim/secureenumconverter.inc"
+
+template <typename SUT>
+void benchToInternal(const char* name, const std::vector<Code>& inputs) {
+    benchRun(name, inputs.size(), 10, [&] {
+        unsigned converted = 0;
+        for (Code code : inputs) {
+            const auto status = SUT::toInternalOpt(code);
+            converted += status ? static_cast<unsigned>(*status) : 0;
+        }
+        benchDoNotOptimize(converted);
+    });
+}
+
+int main() {
+    const std::vector<Code> codes {
+        Code::C00, Code::C01, Code::C02, Code::C03, Code::C04, Code::C05,
+        Code::C06, Code::C07, Code::C08, Code::C09, Code::C10, Code::C11,
+        Code::C12, Code::C13, Code::C14, Code::C15, Code::C16, Code::C17,
+        Code::C18, Code::C19, Code::C20, Code::C21, Code::C22, Code::C23,
+    };
+    const auto inputs = benchRandomInputs(codes, 1 << 22);
+
+    std::cout << "Sparse codes to internal, random inputs" << std::endl;
+    benchToInternal<SwitchSUT>("Switch", inputs);
+    benchToInternal<SortedSUT>("SortedKeys", inputs);
+
+}
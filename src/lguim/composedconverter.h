@@ -0,0 +1,277 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_COMPOSEDCONVERTER_H_
+#define LGUIM_COMPOSEDCONVERTER_H_
+
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "lguim/enumdomain.h"
+
+namespace lguim {
+
+namespace priv {
+
+/** Tags of the sides of a converter: the ones of a `TaggedEnumConverter`,
+ * `side::Internal` and `side::External` otherwise.
+ */
+template <typename Converter>
+struct SideTags {
+    using Internal = side::Internal;
+    using External = side::External;
+};
+
+template <
+    typename InternalTag, typename InternalType,
+    typename ExternalTag, typename ExternalType, typename Tag
+>
+struct SideTags<TaggedEnumConverter<
+    InternalTag, InternalType, ExternalTag, ExternalType, Tag>> {
+    using Internal = InternalTag;
+    using External = ExternalTag;
+};
+
+/** Sides of two converters sharing one of their types: the shared type is
+ * on the `firstMiddleExternal` side of `First`, and on the
+ * `secondMiddleInternal` side of `Second`.
+ */
+template <typename First, typename Second>
+struct Composition {
+    using FirstBase = typename First::Converter;
+    using SecondBase = typename Second::Converter;
+
+    static constexpr bool firstMiddleExternal =
+        std::is_same<typename FirstBase::External,
+            typename SecondBase::Internal>::value
+        || std::is_same<typename FirstBase::External,
+            typename SecondBase::External>::value;
+
+    using Middle = typename std::conditional<
+        firstMiddleExternal,
+        typename FirstBase::External, typename FirstBase::Internal>::type;
+
+    static constexpr bool secondMiddleInternal =
+        std::is_same<typename SecondBase::Internal, Middle>::value;
+
+    static_assert(
+        secondMiddleInternal
+            || std::is_same<typename SecondBase::External, Middle>::value,
+        "ComposedConverter: the converters have no type in common");
+
+    using Internal = typename std::conditional<
+        firstMiddleExternal,
+        typename FirstBase::Internal, typename FirstBase::External>::type;
+    using External = typename std::conditional<
+        secondMiddleInternal,
+        typename SecondBase::External, typename SecondBase::Internal>::type;
+
+    using InternalTag = typename std::conditional<
+        firstMiddleExternal,
+        typename SideTags<First>::Internal,
+        typename SideTags<First>::External>::type;
+    using ExternalTag = typename std::conditional<
+        secondMiddleInternal,
+        typename SideTags<Second>::External,
+        typename SideTags<Second>::Internal>::type;
+
+    /** Conversions of `Base` in the direction from `Input` to the other
+     * type.
+     */
+    template <typename Base, typename Input>
+    using Step = ConversionSource<
+        MappingDirection<
+            std::is_same<typename Base::Internal, Input>::value, Base>,
+        Base>;
+};
+
+/** Source of the conversions through `FirstSource` then `SecondSource`:
+ * keys whose payload in the first one is a key of the second one. The
+ * values without conversion in either step have none.
+ */
+template <typename FirstSource, typename SecondSource>
+struct ComposedSource {
+    using Key = typename FirstSource::Key;
+    using Payload = typename SecondSource::Payload;
+
+    static constexpr std::size_t size = FirstSource::size;
+
+    static constexpr bool has(std::size_t i) {
+        return FirstSource::has(i) && second(i) != SecondSource::size;
+    }
+
+    static constexpr Key key(std::size_t i) { return FirstSource::key(i); }
+
+    static constexpr Payload payload(std::size_t i)
+    { return SecondSource::payload(second(i)); }
+
+ private:
+    static constexpr std::size_t second(std::size_t i)
+    { return SourceScan<SecondSource>::find(FirstSource::payload(i)); }
+};
+
+/** Conversion through a lookup in `Source`, with the interface of the
+ * conversion engines.
+ */
+template <typename Source, typename InputType, typename OutputType>
+struct SourceConverter {
+    using Input = InputType;
+    using Output = OutputType;
+
+    static SEC_CONSTEXPR SEC_OPTIONAL_NS::optional<Output>
+    convertOpt(Input input) {
+        typename Source::Payload payload{};
+
+        if (!SourceLookup<Source>::find(toUnderlying(input), payload)) {
+            return SEC_OPTIONAL_NS::nullopt;
+        }
+
+        return static_cast<Output>(payload);
+    }
+
+    static constexpr std::size_t tableBytes()
+    { return SourceLookup<Source>::tableBytes(); }
+};
+
+}  // namespace priv
+
+/** `ComposedConverter` converts between the two outer types of a chain of
+ * two converters sharing a type, such as `A` and `C` for converters
+ * between `A` and `B` and between `B` and `C`. Example:
+ *
+ * ```
+ * using DomainToCanonical = lguim::SecureEnumConverter<Domain, Canonical>;
+ * using CanonicalToWire = lguim::SecureEnumConverter<Canonical, Wire>;
+ * using Converter =
+ *     lguim::ComposedConverter<DomainToCanonical, CanonicalToWire>;
+ *
+ * Converter::toExternalOpt(Domain::D1);  // Optional Wire value
+ * ```
+ *
+ * The internal type is the one of the first converter which is not shared,
+ * the external type the one of the second converter. Either may be a
+ * `TaggedEnumConverter`, whose tags of the outer types then select the
+ * direction of `convertOpt`, like `side::Internal` and `side::External`.
+ *
+ * The conversions of both mappings are fused at compile time into one
+ * lookup per direction: a value converts when it converts in the first
+ * step and its conversion converts in the second one, so orphans of either
+ * mapping have no conversion. Both mappings must be visible, with both
+ * types enumerations, as for `EnumDomain`.
+ */
+template <typename First, typename Second>
+class ComposedConverter {
+    using Composition = priv::Composition<First, Second>;
+    using FirstBase = typename Composition::FirstBase;
+    using SecondBase = typename Composition::SecondBase;
+
+ public:
+    using Internal = typename Composition::Internal;
+    using Middle = typename Composition::Middle;
+    using External = typename Composition::External;
+
+ private:
+    using ToExternal = priv::SourceConverter<
+        priv::ComposedSource<
+            typename Composition::template Step<FirstBase, Internal>,
+            typename Composition::template Step<SecondBase, Middle>>,
+        Internal, External>;
+
+    using ToInternal = priv::SourceConverter<
+        priv::ComposedSource<
+            typename Composition::template Step<SecondBase, External>,
+            typename Composition::template Step<FirstBase, Middle>>,
+        External, Internal>;
+
+    template <typename DirectionTag>
+    struct Direction {
+        static constexpr bool external =
+            std::is_same<DirectionTag, side::External>::value
+            || std::is_same<
+                DirectionTag, typename Composition::ExternalTag>::value;
+
+        static_assert(
+            external || std::is_same<DirectionTag, side::Internal>::value
+                || std::is_same<
+                    DirectionTag, typename Composition::InternalTag>::value,
+            "ComposedConverter: not a tag of the outer types");
+
+        using Engine = typename std::conditional<
+            external, ToExternal, ToInternal>::type;
+    };
+
+ public:
+    template <typename DirectionTag>
+    using Input = typename Direction<DirectionTag>::Engine::Input;
+
+    template <typename DirectionTag>
+    using Output = typename Direction<DirectionTag>::Engine::Output;
+
+    static SEC_CONSTEXPR SEC_OPTIONAL_NS::optional<Internal>
+    toInternalOpt(External external)
+    { return ToInternal::convertOpt(external); }
+
+    static SEC_CONSTEXPR SEC_OPTIONAL_NS::optional<External>
+    toExternalOpt(Internal internal)
+    { return ToExternal::convertOpt(internal); }
+
+    static Internal toInternalOrThrow(External external)
+    { return orThrow<ToInternal>(external); }
+
+    static External toExternalOrThrow(Internal internal)
+    { return orThrow<ToExternal>(internal); }
+
+    /** See `SecureEnumConverter::toInternalBatch`. */
+    static BatchResult toInternalBatch(
+        const External* input, std::size_t count, Internal* output)
+    { return priv::convertBatch<ToInternal>(input, count, output); }
+
+    static BatchResult toExternalBatch(
+        const Internal* input, std::size_t count, External* output)
+    { return priv::convertBatch<ToExternal>(input, count, output); }
+
+    /** Bytes of the tables of the fused lookups, zero when a direction is
+     * a constant offset.
+     */
+    static constexpr std::size_t tableBytes()
+    { return ToInternal::tableBytes() + ToExternal::tableBytes(); }
+
+    template <typename DirectionTag>
+    static SEC_CONSTEXPR SEC_OPTIONAL_NS::optional<Output<DirectionTag>>
+    convertOpt(Input<DirectionTag> input)
+    { return Direction<DirectionTag>::Engine::convertOpt(input); }
+
+    template <typename DirectionTag>
+    static Output<DirectionTag> convertOrThrow(Input<DirectionTag> input)
+    { return orThrow<typename Direction<DirectionTag>::Engine>(input); }
+
+    template <typename DirectionTag>
+    static BatchResult convertBatch(
+        const Input<DirectionTag>* input, std::size_t count,
+        Output<DirectionTag>* output) {
+        return priv::convertBatch<typename Direction<DirectionTag>::Engine>(
+            input, count, output);
+    }
+
+ private:
+    static const char* converter() { return __PRETTY_FUNCTION__; }
+
+    template <typename Engine>
+    static typename Engine::Output orThrow(typename Engine::Input input) {
+        const auto& outputOpt = Engine::convertOpt(input);
+
+        if (!outputOpt) {
+            std::ostringstream oss;
+            oss << "Invalid enum value (" << converter() << ")";
+            throw std::invalid_argument(oss.str());
+        }
+
+        return *outputOpt;
+    }
+};
+
+}  // namespace lguim
+
+#endif  // LGUIM_COMPOSEDCONVERTER_H_
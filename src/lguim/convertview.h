@@ -0,0 +1,472 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_CONVERTVIEW_H_
+#define LGUIM_CONVERTVIEW_H_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 202002L
+    #include <ranges>
+#endif
+
+#include "lguim/enumdomain.h"
+
+namespace lguim {
+
+namespace priv {
+
+/** Direction of a view converting to `ToSide`. */
+template <typename Converter, typename ToSide>
+using ViewHalfConverter = OneDirectionConverter<
+    SideOf<Converter, ToSide>::external, typename Converter::Converter>;
+
+/** Storage of the range of a view: a pointer for lvalues, the range itself
+ * for rvalues.
+ */
+template <typename Range>
+class RangeHolder {
+ public:
+    RangeHolder() : range_() {}
+    explicit RangeHolder(Range&& range) : range_(std::move(range)) {}
+
+    const Range& get() const { return range_; }
+
+ private:
+    Range range_;
+};
+
+template <typename Range>
+class RangeHolder<Range&> {
+ public:
+    RangeHolder() : range_(nullptr) {}
+    explicit RangeHolder(Range& range) : range_(&range) {}
+
+    const Range& get() const { return *range_; }
+
+ private:
+    Range* range_;
+};
+
+template <typename Range>
+using RangeIterator = decltype(std::begin(
+    std::declval<const typename std::remove_reference<Range>::type&>()));
+
+/** Category of an iterator, at most random access. */
+template <typename Iterator>
+using CappedCategory = typename std::conditional<
+    std::is_base_of<
+        std::random_access_iterator_tag,
+        typename std::iterator_traits<Iterator>::iterator_category>::value,
+    std::random_access_iterator_tag,
+    typename std::iterator_traits<Iterator>::iterator_category
+>::type;
+
+/** Access to the values of ranges stored contiguously: arrays, and the
+ * containers whose `data()` gives a pointer to `Input`.
+ */
+template <typename Range, typename Input, typename = void>
+struct ContiguousRange {
+    static constexpr bool value = false;
+};
+
+template <typename Range, typename Input>
+struct ContiguousRange<Range, Input, typename std::enable_if<std::is_same<
+    decltype(std::declval<const Range&>().data()), const Input*>::value
+>::type> {
+    static constexpr bool value = true;
+
+    static const Input* data(const Range& range) { return range.data(); }
+    static std::size_t size(const Range& range) { return range.size(); }
+};
+
+template <typename Input, std::size_t count>
+struct ContiguousRange<Input[count], Input, void> {
+    static constexpr bool value = true;
+
+    static const Input* data(const Input (&range)[count]) { return range; }
+    static std::size_t size(const Input (&)[count]) { return count; }
+};
+
+}  // namespace priv
+
+/** Iterator of `ConvertView`, converting the values of `BaseIterator` when
+ * dereferenced.
+ */
+template <typename HalfConverter, typename BaseIterator>
+class ConvertIterator {
+ public:
+    using iterator_category = priv::CappedCategory<BaseIterator>;
+    using iterator_concept = iterator_category;
+    using value_type = typename HalfConverter::Output;
+    using difference_type =
+        typename std::iterator_traits<BaseIterator>::difference_type;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    ConvertIterator() : base_() {}
+    explicit ConvertIterator(BaseIterator base) : base_(base) {}
+
+    const BaseIterator& base() const { return base_; }
+
+    /** Conversion of the value. Throws `std::invalid_argument` when it has
+     * no conversion.
+     */
+    value_type operator*() const
+    { return HalfConverter::convertOrThrow(*base_); }
+
+    value_type operator[](difference_type n) const
+    { return HalfConverter::convertOrThrow(base_[n]); }
+
+    ConvertIterator& operator++() {
+        ++base_;
+        return *this;
+    }
+
+    ConvertIterator& operator--() {
+        --base_;
+        return *this;
+    }
+
+    ConvertIterator operator++(int) {
+        ConvertIterator previous = *this;
+        ++base_;
+        return previous;
+    }
+
+    ConvertIterator operator--(int) {
+        ConvertIterator previous = *this;
+        --base_;
+        return previous;
+    }
+
+    ConvertIterator& operator+=(difference_type n) {
+        base_ += n;
+        return *this;
+    }
+
+    ConvertIterator& operator-=(difference_type n) {
+        base_ -= n;
+        return *this;
+    }
+
+    friend ConvertIterator operator+(ConvertIterator it, difference_type n)
+    { return it += n; }
+
+    friend ConvertIterator operator+(difference_type n, ConvertIterator it)
+    { return it += n; }
+
+    friend ConvertIterator operator-(ConvertIterator it, difference_type n)
+    { return it -= n; }
+
+    friend difference_type operator-(
+        const ConvertIterator& lhs, const ConvertIterator& rhs)
+    { return lhs.base_ - rhs.base_; }
+
+    friend bool operator==(
+        const ConvertIterator& lhs, const ConvertIterator& rhs)
+    { return lhs.base_ == rhs.base_; }
+
+    friend bool operator!=(
+        const ConvertIterator& lhs, const ConvertIterator& rhs)
+    { return lhs.base_ != rhs.base_; }
+
+    friend bool operator<(
+        const ConvertIterator& lhs, const ConvertIterator& rhs)
+    { return lhs.base_ < rhs.base_; }
+
+    friend bool operator>(
+        const ConvertIterator& lhs, const ConvertIterator& rhs)
+    { return lhs.base_ > rhs.base_; }
+
+    friend bool operator<=(
+        const ConvertIterator& lhs, const ConvertIterator& rhs)
+    { return lhs.base_ <= rhs.base_; }
+
+    friend bool operator>=(
+        const ConvertIterator& lhs, const ConvertIterator& rhs)
+    { return lhs.base_ >= rhs.base_; }
+
+ private:
+    BaseIterator base_;
+};
+
+/** Iterator of `ConvertibleView`, skipping the values which have no
+ * conversion.
+ */
+template <typename HalfConverter, typename BaseIterator>
+class ConvertibleIterator {
+ public:
+    using iterator_category = typename std::conditional<
+        std::is_base_of<
+            std::forward_iterator_tag,
+            priv::CappedCategory<BaseIterator>>::value,
+        std::forward_iterator_tag,
+        std::input_iterator_tag
+    >::type;
+    using iterator_concept = iterator_category;
+    using value_type = typename HalfConverter::Output;
+    using difference_type =
+        typename std::iterator_traits<BaseIterator>::difference_type;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    ConvertibleIterator() : base_(), end_() {}
+
+    ConvertibleIterator(BaseIterator base, BaseIterator end)
+        : base_(skip(base, end)), end_(end) {}
+
+    const BaseIterator& base() const { return base_; }
+
+    value_type operator*() const
+    { return *HalfConverter::convertOpt(*base_); }
+
+    ConvertibleIterator& operator++() {
+        base_ = skip(++base_, end_);
+        return *this;
+    }
+
+    ConvertibleIterator operator++(int) {
+        ConvertibleIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    friend bool operator==(
+        const ConvertibleIterator& lhs, const ConvertibleIterator& rhs)
+    { return lhs.base_ == rhs.base_; }
+
+    friend bool operator!=(
+        const ConvertibleIterator& lhs, const ConvertibleIterator& rhs)
+    { return lhs.base_ != rhs.base_; }
+
+ private:
+    static BaseIterator skip(BaseIterator it, const BaseIterator& end) {
+        while (it != end && !HalfConverter::isConvertible(*it)) {
+            ++it;
+        }
+        return it;
+    }
+
+    BaseIterator base_;
+    BaseIterator end_;
+};
+
+/** Lazy conversion of the values of a range to `ToSide`, which is
+ * `side::Internal`, `side::External` or one of the tags of a
+ * `TaggedEnumConverter`. See `views::convert`.
+ */
+template <typename Converter, typename ToSide, typename Range>
+class ConvertView
+#if __cplusplus >= 202002L
+    : public std::ranges::view_base
+#endif
+{
+    using HalfConverter = priv::ViewHalfConverter<Converter, ToSide>;
+    using Stored = typename std::remove_reference<Range>::type;
+    using Contiguous = priv::ContiguousRange<
+        Stored, typename HalfConverter::Input>;
+
+ public:
+    using iterator = ConvertIterator<HalfConverter, priv::RangeIterator<Range>>;
+    using const_iterator = iterator;
+    using value_type = typename HalfConverter::Output;
+
+    ConvertView() : range_() {}
+    explicit ConvertView(Range&& range) : range_(std::forward<Range>(range)) {}
+
+    iterator begin() const { return iterator(std::begin(range_.get())); }
+    iterator end() const { return iterator(std::end(range_.get())); }
+
+    /** Number of values, in constant time for random access ranges. */
+    std::size_t size() const
+    { return static_cast<std::size_t>(std::distance(begin(), end())); }
+
+    bool empty() const { return begin() == end(); }
+
+    /** Converts all the values to `output`, like `toExternalBatch`: values
+     * without conversion are counted and their outputs left untouched.
+     * Ranges stored contiguously go through the batch conversion and its
+     * vector kernels.
+     */
+    BatchResult convertTo(value_type* output) const {
+        return convertTo(
+            output, std::integral_constant<bool, Contiguous::value>());
+    }
+
+ private:
+    BatchResult convertTo(value_type* output, std::true_type) const {
+        return HalfConverter::convertBatch(
+            Contiguous::data(range_.get()), Contiguous::size(range_.get()),
+            output);
+    }
+
+    BatchResult convertTo(value_type* output, std::false_type) const {
+        BatchResult result{0, 0};
+        std::size_t i = 0;
+
+        for (auto it = std::begin(range_.get()); it != std::end(range_.get());
+             ++it, ++i) {
+            const auto converted = HalfConverter::convertOpt(*it);
+
+            if (converted) {
+                output[i] = *converted;
+            } else if (result.invalidCount++ == 0) {
+                result.firstInvalid = i;
+            }
+        }
+
+        if (result.invalidCount == 0) {
+            result.firstInvalid = i;
+        }
+        return result;
+    }
+
+    priv::RangeHolder<Range> range_;
+};
+
+/** Lazy conversion of the values of a range which have a conversion, the
+ * others being skipped. See `views::convertible`.
+ */
+template <typename Converter, typename ToSide, typename Range>
+class ConvertibleView
+#if __cplusplus >= 202002L
+    : public std::ranges::view_base
+#endif
+{
+    using HalfConverter = priv::ViewHalfConverter<Converter, ToSide>;
+    using Input = typename HalfConverter::Input;
+    using Stored = typename std::remove_reference<Range>::type;
+    using Contiguous = priv::ContiguousRange<Stored, Input>;
+
+ public:
+    using iterator =
+        ConvertibleIterator<HalfConverter, priv::RangeIterator<Range>>;
+    using const_iterator = iterator;
+    using value_type = typename HalfConverter::Output;
+
+    ConvertibleView() : range_() {}
+    explicit ConvertibleView(Range&& range)
+        : range_(std::forward<Range>(range)) {}
+
+    iterator begin() const {
+        return iterator(std::begin(range_.get()), std::end(range_.get()));
+    }
+
+    iterator end() const
+    { return iterator(std::end(range_.get()), std::end(range_.get())); }
+
+    bool empty() const { return begin() == end(); }
+
+    /** Writes the conversions of the values which have one to `output`,
+     * one after the other, returning their number. Ranges stored
+     * contiguously are processed by runs of valid values, found with
+     * `firstInvalid` and converted with the batch conversion.
+     */
+    std::size_t convertTo(value_type* output) const {
+        return convertTo(
+            output, std::integral_constant<bool, Contiguous::value>());
+    }
+
+ private:
+    std::size_t convertTo(value_type* output, std::true_type) const {
+        const Input* input = Contiguous::data(range_.get());
+        const std::size_t count = Contiguous::size(range_.get());
+        std::size_t written = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t run =
+                HalfConverter::firstInvalid(input + i, count - i);
+            HalfConverter::convertBatch(input + i, run, output + written);
+            written += run;
+            i += run;
+        }
+
+        return written;
+    }
+
+    std::size_t convertTo(value_type* output, std::false_type) const {
+        std::size_t written = 0;
+        for (value_type value : *this) {
+            output[written++] = value;
+        }
+        return written;
+    }
+
+    priv::RangeHolder<Range> range_;
+};
+
+namespace views {
+
+/** Result of `views::convert<Converter, ToSide>()`, applied to a range with
+ * `operator|`.
+ */
+template <typename Converter, typename ToSide>
+struct ConvertAdaptor {};
+
+template <typename Converter, typename ToSide>
+struct ConvertibleAdaptor {};
+
+/** Lazy view of the conversions of the values of `range`, without
+ * allocation. The conversion happens when an element is accessed, and
+ * throws `std::invalid_argument` when the value has no conversion. The
+ * view keeps the category of the iterators of the range, up to random
+ * access. Example:
+ *
+ * ```
+ * for (B b : lguim::views::convert<Converter, TB>(values)) {
+ *     // ...
+ * }
+ *
+ * auto view = values | lguim::views::convert<Converter, TB>();
+ * std::vector<B> converted(view.size());
+ * view.convertTo(converted.data());  // Batch conversion
+ * ```
+ *
+ * An lvalue range is referenced, and must outlive the view; an rvalue
+ * range is moved into the view.
+ */
+template <typename Converter, typename ToSide, typename Range>
+ConvertView<Converter, ToSide, Range> convert(Range&& range) {
+    return ConvertView<Converter, ToSide, Range>(std::forward<Range>(range));
+}
+
+template <typename Converter, typename ToSide>
+ConvertAdaptor<Converter, ToSide> convert()
+{ return ConvertAdaptor<Converter, ToSide>(); }
+
+/** Lazy view of the conversions of the values of `range` which have one,
+ * skipping the others (orphans and unknown values). The iterators are at
+ * most forward iterators. See `convert`.
+ */
+template <typename Converter, typename ToSide, typename Range>
+ConvertibleView<Converter, ToSide, Range> convertible(Range&& range) {
+    return ConvertibleView<Converter, ToSide, Range>(
+        std::forward<Range>(range));
+}
+
+template <typename Converter, typename ToSide>
+ConvertibleAdaptor<Converter, ToSide> convertible()
+{ return ConvertibleAdaptor<Converter, ToSide>(); }
+
+template <typename Range, typename Converter, typename ToSide>
+ConvertView<Converter, ToSide, Range> operator|(
+    Range&& range, ConvertAdaptor<Converter, ToSide>) {
+    return ConvertView<Converter, ToSide, Range>(std::forward<Range>(range));
+}
+
+template <typename Range, typename Converter, typename ToSide>
+ConvertibleView<Converter, ToSide, Range> operator|(
+    Range&& range, ConvertibleAdaptor<Converter, ToSide>) {
+    return ConvertibleView<Converter, ToSide, Range>(
+        std::forward<Range>(range));
+}
+
+}  // namespace views
+
+}  // namespace lguim
+
+#endif  // LGUIM_CONVERTVIEW_H_
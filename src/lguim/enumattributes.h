@@ -0,0 +1,154 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_ENUMATTRIBUTES_H_
+#define LGUIM_ENUMATTRIBUTES_H_
+
+#include <cstddef>
+#include <type_traits>
+
+#include "lguim/enumdomain.h"
+
+namespace lguim {
+
+namespace priv {
+
+/** Last member of the rows of attributes: a row missing a column fails to
+ * initialize it.
+ */
+struct AttributeRowEnd {};
+
+/** Value of the entry of the columns past the last ordinal. */
+template <typename T>
+constexpr T defaultAttribute() { return T(); }
+
+template <bool external>
+using SideType = typename std::conditional<
+    external, side::External, side::Internal>::type;
+
+/** Rows of `SEC_ATTRIBUTES` for one side of `Converter`, defined by
+ * enumattributes.inc.
+ */
+template <typename Converter, bool external, typename Dummy = void>
+struct AttributeRows;
+
+/** Rows of attributes by ordinal in `EnumDomain`. */
+template <typename Converter, bool external>
+struct AttributeIndex {
+    using Rows = AttributeRows<Converter, external>;
+    using Row = typename Rows::Row;
+    using Domain = EnumDomain<Converter, SideType<external>>;
+
+    static constexpr std::size_t rowCount =
+        sizeof(Rows::rows) / sizeof(Rows::rows[0]);
+
+    /** Index of the row of the value of `ordinal`, or `rowCount`. */
+    static constexpr std::size_t find(
+        std::size_t ordinal,
+        std::size_t begin = 0, std::size_t end = rowCount) {
+        return end - begin == 0 ? rowCount
+            : end - begin == 1
+                ? (Rows::rows[begin].value == Domain::value(ordinal)
+                    ? begin : rowCount)
+            : lower(find(ordinal, begin, begin + (end - begin) / 2),
+                find(ordinal, begin + (end - begin) / 2, end));
+    }
+
+    /** Whether all the ordinals in [begin, end) have a row. */
+    static constexpr bool complete(std::size_t begin, std::size_t end) {
+        return end - begin == 0 ? true
+            : end - begin == 1 ? find(begin) != rowCount
+            : complete(begin, begin + (end - begin) / 2)
+                && complete(begin + (end - begin) / 2, end);
+    }
+
+    static constexpr const Row& row(std::size_t ordinal) {
+        return Rows::rows[find(ordinal) != rowCount ? find(ordinal) : 0];
+    }
+
+ private:
+    static constexpr std::size_t lower(std::size_t a, std::size_t b)
+    { return a < b ? a : b; }
+};
+
+/** Base of the columns of attributes of one side of `Converter`. */
+template <typename Converter, bool external>
+struct AttributeTable {
+    using Index = AttributeIndex<Converter, external>;
+    using Domain = typename Index::Domain;
+    using Value = typename Domain::Value;
+
+    static_assert(
+        Index::complete(0, Domain::size),
+        "SEC_ATTRIBUTES: a value of the mapping has no row");
+
+    static_assert(
+        Index::rowCount == Domain::size,
+        "SEC_ATTRIBUTES: a value has several rows or is not in the mapping");
+
+    /** Number of values, the index of the last entry of the columns. */
+    static constexpr std::size_t size = Domain::size;
+
+    /** Index of the attributes of `value`, or `size` when the mapping does
+     * not mention it.
+     */
+    static SEC_CONSTEXPR std::size_t ordinalOf(Value value)
+    { return Domain::ordinal(value); }
+
+    /** Index of the attributes of the conversion of `input`, or `size` when
+     * it has no conversion.
+     */
+    static std::size_t conversionOrdinal(
+        typename TargetOrdinal<Converter, SideType<external>>::Input input)
+    { return TargetOrdinal<Converter, SideType<external>>::of(input); }
+};
+
+template <typename Converter, bool external>
+constexpr std::size_t AttributeTable<Converter, external>::size;
+
+/** Columns of attributes, defined by enumattributes.inc. */
+template <
+    typename Converter, bool external,
+    typename Ordinals = typename MakeIndexSequence<
+        EnumDomain<Converter, SideType<external>>::size>::Type
+>
+struct AttributeColumns;
+
+}  // namespace priv
+
+/** Attributes of the values of one side of a converter, as columns indexed
+ * by the ordinals of `EnumDomain`. They are defined after the mapping by
+ * including enumattributes.inc:
+ *
+ * ```
+ * #define SEC_TYPE Converter
+ * #define SEC_SIDE lguim::side::External
+ * #define SEC_COLUMNS \
+ *     SEC_COLUMN(priority, int) \
+ *     SEC_COLUMN(name, const char*)
+ * #define SEC_ATTRIBUTES \
+ *     SEC_ROW(B::B1, 3, "first") \
+ *     SEC_ROW(B::B2, 1, "second")
+ * #include "lguim/enumattributes.inc"
+ *
+ * using Attributes = lguim::EnumAttributes<Converter, lguim::side::External>;
+ * const char* name = Attributes::name[Attributes::conversionOrdinal(a)];
+ * ```
+ *
+ * Each column is a constant array with one entry per value, in any order
+ * in `SEC_ATTRIBUTES`, and a last value-initialized entry at `size`, the
+ * ordinal given to the values without conversion or outside the mapping:
+ * the result of `ordinalOf` or `conversionOrdinal` indexes all the columns
+ * without check. Every value of the side, orphans included, must have
+ * exactly one row with all the columns, which is checked at compile time.
+ *
+ * `Side` is `side::Internal` or `side::External`, or one of the tags of a
+ * `TaggedEnumConverter`. Like `EnumDomain`, this needs the mapping rows.
+ */
+template <typename Converter, typename Side>
+using EnumAttributes = priv::AttributeColumns<
+    typename Converter::Converter, priv::SideOf<Converter, Side>::external>;
+
+}  // namespace lguim
+
+#endif  // LGUIM_ENUMATTRIBUTES_H_
@@ -0,0 +1,383 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_ENUMCODES_H_
+#define LGUIM_ENUMCODES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include "lguim/secureenumconverter.h"
+#include "lguim/secureenumconverter_simd.h"
+
+namespace lguim {
+
+enum class ByteOrder { Little, Big };
+
+/** Layout of codes in a byte buffer: integers of `width` bytes (1, 2, 4 or
+ * 8) in `order`, the first one at the start of the buffer and each next one
+ * `stride` bytes further.
+ */
+struct CodeLayout {
+    std::size_t width;
+    ByteOrder order;
+    std::size_t stride;
+};
+
+namespace priv {
+
+template <std::size_t width>
+struct CodeWord;
+
+template <>
+struct CodeWord<1> {
+    using Type = std::uint8_t;
+    static Type swap(Type word) { return word; }
+};
+
+template <>
+struct CodeWord<2> {
+    using Type = std::uint16_t;
+    static Type swap(Type word) { return __builtin_bswap16(word); }
+};
+
+template <>
+struct CodeWord<4> {
+    using Type = std::uint32_t;
+    static Type swap(Type word) { return __builtin_bswap32(word); }
+};
+
+template <>
+struct CodeWord<8> {
+    using Type = std::uint64_t;
+    static Type swap(Type word) { return __builtin_bswap64(word); }
+};
+
+/** Reads codes of `width` bytes, in big-endian order when `bigEndian`, as
+ * integers of the signedness of the underlying type of `External`.
+ */
+template <typename External, std::size_t width, bool bigEndian>
+struct CodeReader {
+    using Raw = typename std::underlying_type<External>::type;
+    using Word = typename CodeWord<width>::Type;
+    using Code = typename std::conditional<
+        std::is_signed<Raw>::value,
+        typename std::make_signed<Word>::type,
+        Word
+    >::type;
+
+    static constexpr bool swaps =
+        bigEndian != (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__);
+
+    static Code read(const unsigned char* bytes) {
+        Word word;
+        std::memcpy(&word, bytes, width);
+
+        return static_cast<Code>(swaps ? CodeWord<width>::swap(word) : word);
+    }
+};
+
+/** Copies `count` contiguous codes of `width` bytes to `codes`, swapping
+ * their bytes when `swaps`, with vector byte shuffles for the instruction
+ * sets which have them.
+ */
+template <std::size_t width, bool swaps>
+struct CodeCopy {
+    using Word = typename CodeWord<width>::Type;
+
+    static void run(
+        Isa isa, const unsigned char* bytes, std::size_t count, void* codes) {
+        std::size_t done = 0;
+#if LGUIM_SEC_SIMD_X86
+        if (swaps && isa >= Isa::Avx2) {
+            done = avx2(bytes, count, static_cast<unsigned char*>(codes));
+        } else if (swaps && isa == Isa::Sse42) {
+            done = sse42(bytes, count, static_cast<unsigned char*>(codes));
+        }
+#else
+        static_cast<void>(isa);
+#endif
+        Word* words = static_cast<Word*>(codes);
+        for (std::size_t i = done; i < count; ++i) {
+            Word word;
+            std::memcpy(&word, bytes + i * width, width);
+            words[i] = swaps ? CodeWord<width>::swap(word) : word;
+        }
+    }
+
+#if LGUIM_SEC_SIMD_X86
+ private:
+    // Byte `j` of each 16 bytes comes from the byte of its word mirrored
+    // around the middle of the word.
+    __attribute__((target("sse4.2")))
+    static __m128i mirror() {
+        alignas(16) char indices[16];
+        for (std::size_t j = 0; j < 16; ++j) {
+            indices[j] = static_cast<char>(
+                j / width * width + width - 1 - j % width);
+        }
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(indices));
+    }
+
+    __attribute__((target("avx2")))
+    static std::size_t avx2(
+        const unsigned char* bytes, std::size_t count, unsigned char* codes) {
+        const __m256i indices = _mm256_broadcastsi128_si256(mirror());
+        const std::size_t lanes = 32 / width;
+
+        std::size_t i = 0;
+        for (; i + lanes <= count; i += lanes) {
+            _mm256_storeu_si256(
+                reinterpret_cast<__m256i*>(codes + i * width),
+                _mm256_shuffle_epi8(
+                    _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i*>(bytes + i * width)),
+                    indices));
+        }
+        return i;
+    }
+
+    __attribute__((target("sse4.2")))
+    static std::size_t sse42(
+        const unsigned char* bytes, std::size_t count, unsigned char* codes) {
+        const __m128i indices = mirror();
+        const std::size_t lanes = 16 / width;
+
+        std::size_t i = 0;
+        for (; i + lanes <= count; i += lanes) {
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(codes + i * width),
+                _mm_shuffle_epi8(
+                    _mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(bytes + i * width)),
+                    indices));
+        }
+        return i;
+    }
+#endif  // LGUIM_SEC_SIMD_X86
+};
+
+/** Adds the result of the block of values starting at `begin` to
+ * `result`.
+ */
+inline void addBlock(
+    BatchResult& result, const BatchResult& block, std::size_t begin) {
+    if (block.invalidCount != 0 && result.invalidCount == 0) {
+        result.firstInvalid = begin + block.firstInvalid;
+    }
+    result.invalidCount += block.invalidCount;
+}
+
+constexpr std::size_t codeBlockSize = 64;
+
+/** Decodes contiguous codes of the size of the underlying type, which
+ * always fit it: they are swapped to the block as a whole.
+ */
+template <typename Converter, std::size_t width, bool bigEndian>
+inline BatchResult decodeContiguous(
+    const unsigned char* bytes, std::size_t count,
+    typename Converter::Internal* output, std::uint8_t* validity) {
+    using Reader = CodeReader<typename Converter::External, width, bigEndian>;
+    using Raw = typename Reader::Raw;
+
+    const Isa isa = detectIsa();
+    BatchResult result{0, count};
+
+    for (std::size_t begin = 0; begin < count; begin += codeBlockSize) {
+        const std::size_t size =
+            count - begin < codeBlockSize ? count - begin : codeBlockSize;
+
+        alignas(32) Raw codes[codeBlockSize];
+        CodeCopy<width, Reader::swaps>::run(
+            isa, bytes + begin * width, size, codes);
+
+        addBlock(result, Converter::fromUnderlyingBatch(
+            codes, size, output + begin,
+            validity != nullptr ? validity + begin / 8 : nullptr),
+            begin);
+    }
+
+    return result;
+}
+
+/** Converts a block of `size` codes, of which only those whose bit is set
+ * in `fits` fit the underlying type. Kept out of the loop of the blocks,
+ * whose conversion it would slow down.
+ */
+template <typename Converter>
+__attribute__((noinline))
+BatchResult decodeUnfit(
+    const UnderlyingType<typename Converter::External>* codes,
+    std::size_t size, std::uint64_t fits,
+    typename Converter::Internal* output, std::uint8_t* validity) {
+    typename Converter::Internal converted[codeBlockSize] = {};
+    std::uint8_t convertible[codeBlockSize / 8];
+    Converter::fromUnderlyingBatch(codes, size, converted, convertible);
+
+    std::uint64_t valid = 0;
+    for (std::size_t byte = 0; byte < (size + 7) / 8; ++byte) {
+        valid |= std::uint64_t{convertible[byte]} << (8 * byte);
+    }
+    valid &= fits;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        if (((valid >> i) & 1) != 0) {
+            output[i] = converted[i];
+        }
+    }
+
+    if (validity != nullptr) {
+        for (std::size_t byte = 0; byte < (size + 7) / 8; ++byte) {
+            validity[byte] = static_cast<std::uint8_t>(valid >> (8 * byte));
+        }
+    }
+
+    const std::uint64_t all = size == codeBlockSize
+        ? ~std::uint64_t{0} : (std::uint64_t{1} << size) - 1;
+    const std::uint64_t invalid = all & ~valid;
+    return BatchResult{
+        static_cast<std::size_t>(__builtin_popcountll(invalid)),
+        static_cast<std::size_t>(__builtin_ctzll(invalid)),
+    };
+}
+
+/** Decodes codes of one width and byte order. See `decodeCodes`. */
+template <typename Converter, std::size_t width, bool bigEndian>
+inline BatchResult decodeCodes(
+    const unsigned char* bytes, std::size_t stride, std::size_t count,
+    typename Converter::Internal* output, std::uint8_t* validity) {
+    using Reader = CodeReader<typename Converter::External, width, bigEndian>;
+    using Raw = typename Reader::Raw;
+
+    if (stride == width && width == sizeof(Raw)) {
+        return decodeContiguous<Converter, width, bigEndian>(
+            bytes, count, output, validity);
+    }
+
+    constexpr std::size_t blockSize = codeBlockSize;
+    BatchResult result{0, count};
+
+    for (std::size_t begin = 0; begin < count; begin += blockSize) {
+        const std::size_t size =
+            count - begin < blockSize ? count - begin : blockSize;
+        const std::uint64_t all = size == blockSize
+            ? ~std::uint64_t{0} : (std::uint64_t{1} << size) - 1;
+
+        // The codes are only copied to the block once byte-swapped
+        Raw codes[blockSize];
+        std::uint64_t fits = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            const typename Reader::Code code =
+                Reader::read(bytes + (begin + i) * stride);
+
+            codes[i] = static_cast<Raw>(code);
+            fits |= std::uint64_t{representable<Raw>(code)} << i;
+        }
+
+        std::uint8_t* blockValidity =
+            validity != nullptr ? validity + begin / 8 : nullptr;
+        if (fits == all) {
+            addBlock(result, Converter::fromUnderlyingBatch(
+                codes, size, output + begin, blockValidity), begin);
+        } else {
+            // Codes out of the range of the underlying type were
+            // truncated: their conversions are dropped
+            addBlock(result, decodeUnfit<Converter>(
+                codes, size, fits, output + begin, blockValidity), begin);
+        }
+    }
+
+    return result;
+}
+
+}  // namespace priv
+
+/** Decodes `count` external codes read from a byte buffer, such as fields
+ * at fixed offsets in received packets, to internal values. Example:
+ *
+ * ```
+ * // Big-endian 16-bit status at offset 2 of packets of 12 bytes
+ * const lguim::BatchResult result = lguim::decodeCodes<Converter>(
+ *     packets + 2, {2, lguim::ByteOrder::Big, 12}, packetCount,
+ *     statuses, statusValidity);
+ * ```
+ *
+ * Code `i` is the integer of `layout.width` bytes at `bytes + i *
+ * layout.stride`, read through `memcpy` so that it may be unaligned. It is
+ * signed, in two's complement, when the underlying type of the external
+ * type is, and unsigned otherwise. Each code is then converted as by
+ * `SecureEnumConverter::fromUnderlying`: codes out of the range of the
+ * underlying type are invalid rather than truncated.
+ *
+ * The bit of each output in `validity`, which holds `(count + 7) / 8`
+ * bytes, is set when its code has a conversion, as in
+ * `SecureEnumConverter::toInternalColumn`; the last bits of the last byte
+ * are cleared. `validity` may be null. Outputs of codes which have no
+ * conversion are left untouched.
+ *
+ * The codes are read and byte-swapped by blocks of 64 into a buffer on the
+ * stack, which is converted with `fromUnderlyingBatch`: its vector kernels
+ * give the validity bits with the conversions. Contiguous codes of the
+ * size of the underlying type, when `layout.stride` is `layout.width`, are
+ * byte-swapped with vector shuffles. Throws `std::invalid_argument` when
+ * the width is not 1, 2, 4 or 8.
+ */
+template <typename Converter>
+BatchResult decodeCodes(
+    const unsigned char* bytes, CodeLayout layout, std::size_t count,
+    typename Converter::Internal* output, std::uint8_t* validity) {
+    using Base = typename Converter::Converter;
+
+    static_assert(
+        std::is_enum<typename Base::External>::value,
+        "decodeCodes: the external type is not an enumeration");
+
+    const bool big = layout.order == ByteOrder::Big;
+    const std::size_t stride = layout.stride;
+
+    switch (layout.width) {
+    case 1:
+        return priv::decodeCodes<Base, 1, false>(
+            bytes, stride, count, output, validity);
+    case 2:
+        return big
+            ? priv::decodeCodes<Base, 2, true>(
+                bytes, stride, count, output, validity)
+            : priv::decodeCodes<Base, 2, false>(
+                bytes, stride, count, output, validity);
+    case 4:
+        return big
+            ? priv::decodeCodes<Base, 4, true>(
+                bytes, stride, count, output, validity)
+            : priv::decodeCodes<Base, 4, false>(
+                bytes, stride, count, output, validity);
+    case 8:
+        return big
+            ? priv::decodeCodes<Base, 8, true>(
+                bytes, stride, count, output, validity)
+            : priv::decodeCodes<Base, 8, false>(
+                bytes, stride, count, output, validity);
+    default:
+        throw std::invalid_argument(
+            "decodeCodes: the width is not 1, 2, 4 or 8 bytes");
+    }
+}
+
+#if __cplusplus >= 201703L
+/** See `decodeCodes` on `unsigned char`. */
+template <typename Converter>
+BatchResult decodeCodes(
+    const std::byte* bytes, CodeLayout layout, std::size_t count,
+    typename Converter::Internal* output, std::uint8_t* validity) {
+    return decodeCodes<Converter>(
+        reinterpret_cast<const unsigned char*>(bytes), layout, count,
+        output, validity);
+}
+#endif
+
+}  // namespace lguim
+
+#endif  // LGUIM_ENUMCODES_H_
@@ -0,0 +1,331 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_ENUMDOMAIN_H_
+#define LGUIM_ENUMDOMAIN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "lguim/secureenumconverter.h"
+
+namespace lguim {
+
+/** Sides of a `SecureEnumConverter`, for the containers indexed by the
+ * values of one side. `TaggedEnumConverter` also accepts its tags.
+ */
+namespace side {
+
+struct Internal {};
+struct External {};
+
+}  // namespace side
+
+namespace priv {
+
+template <typename HalfConverter>
+struct HalfConverterSide;
+
+template <bool toExternal, typename Converter>
+struct HalfConverterSide<OneDirectionConverter<toExternal, Converter>> {
+    static constexpr bool external = toExternal;
+};
+
+/** Whether `Side` designates the external side of `Converter`. */
+template <typename Converter, typename Side>
+struct SideOf:
+    HalfConverterSide<typename Converter::template HalfConverter<Side>> {};
+
+template <typename Converter>
+struct SideOf<Converter, side::Internal> {
+    static constexpr bool external = false;
+};
+
+template <typename Converter>
+struct SideOf<Converter, side::External> {
+    static constexpr bool external = true;
+};
+
+/** Values of one side mentioned by the rows, orphans included. A value
+ * may be mentioned by several rows.
+ */
+template <bool external, typename Converter>
+struct SideRows;
+
+template <typename Converter>  // Internal side
+struct SideRows<false, Converter> {
+    using Value = typename Converter::Internal;
+    using Key = typename std::underlying_type<Value>::type;
+    using Payload = Key;
+
+    static constexpr std::size_t size =
+        sizeof(Mapping<Converter>::rows) / sizeof(Mapping<Converter>::rows[0]);
+
+    static constexpr bool has(std::size_t i)
+    { return Mapping<Converter>::rows[i].kind != RowKind::OrphanExt; }
+
+    static constexpr Key key(std::size_t i)
+    { return toUnderlying(Mapping<Converter>::rows[i].internal); }
+
+    static constexpr Payload payload(std::size_t i) { return key(i); }
+};
+
+template <typename Converter>  // External side
+struct SideRows<true, Converter> {
+    using Value = typename Converter::External;
+    using Key = typename std::underlying_type<Value>::type;
+    using Payload = Key;
+
+    static constexpr std::size_t size =
+        sizeof(Mapping<Converter>::rows) / sizeof(Mapping<Converter>::rows[0]);
+
+    static constexpr bool has(std::size_t i)
+    { return Mapping<Converter>::rows[i].kind != RowKind::OrphanInt; }
+
+    static constexpr Key key(std::size_t i)
+    { return toUnderlying(Mapping<Converter>::rows[i].external); }
+
+    static constexpr Payload payload(std::size_t i) { return key(i); }
+};
+
+/** Source keeping only the first entry for each key. */
+template <typename Source>
+struct FirstKeys {
+    using Key = typename Source::Key;
+    using Payload = typename Source::Payload;
+
+    static constexpr std::size_t size = Source::size;
+
+    static constexpr bool has(std::size_t i) {
+        return Source::has(i)
+            && SourceScan<Source>::find(Source::key(i), 0, i) == Source::size;
+    }
+
+    static constexpr Key key(std::size_t i) { return Source::key(i); }
+    static constexpr Payload payload(std::size_t i)
+    { return Source::payload(i); }
+};
+
+/** Smallest unsigned type holding the ordinals of `count` values and a
+ * sentinel.
+ */
+template <std::size_t count>
+using OrdinalType = typename std::conditional<
+    count <= UINT8_MAX, std::uint8_t,
+typename std::conditional<
+    count <= UINT16_MAX, std::uint16_t,
+    std::uint32_t
+>::type>::type;
+
+/** Source associating each value of a domain to its ordinal. */
+template <typename Universe>
+struct OrdinalSource {
+    using Key = typename Universe::Key;
+    using Payload = OrdinalType<SourceScan<Universe>::count()>;
+
+    static constexpr std::size_t size = Universe::size;
+
+    static constexpr bool has(std::size_t i) { return Universe::has(i); }
+    static constexpr Key key(std::size_t i) { return Universe::key(i); }
+
+    static constexpr Payload payload(std::size_t i) {
+        return static_cast<Payload>(
+            SourceScan<Universe>::countLower(Universe::key(i)));
+    }
+};
+
+/** Lookup in a source built outside of the mapping rows, such as values
+ * to ordinals. The payloads need not be a permutation of the keys, so the
+ * choice is between the three engines working on any source: a complete
+ * range of keys suited to `Permutation` is a `DenseTable` without sentinel.
+ */
+template <typename Source>
+using SourceLookup = typename std::conditional<
+    SourceShape<Source>::affine,
+    OffsetLookup<Source>,
+typename std::conditional<
+    std::is_same<
+        typename AutoEngine<Source>::Type, engine::DenseTable>::value
+    || std::is_same<
+        typename AutoEngine<Source>::Type, engine::Permutation>::value,
+    DenseTable<Source>,
+    SortedTable<Source>
+>::type>::type;
+
+}  // namespace priv
+
+/** Values of one side of a converter, as listed in `SEC_MAPPING` (orphans
+ * included), numbered from zero by increasing underlying value.
+ *
+ * `Side` is `side::Internal` or `side::External`, or one of the tags of a
+ * `TaggedEnumConverter`. Like `EngineReport`, this needs the mapping rows:
+ * the mapping must be visible and both types must be enumerations.
+ */
+template <typename Converter, typename Side>
+struct EnumDomain {
+    using Base = typename Converter::Converter;
+    static constexpr bool external = priv::SideOf<Converter, Side>::external;
+
+    using Value = typename std::conditional<
+        external, typename Base::External, typename Base::Internal>::type;
+
+    using Universe = priv::FirstKeys<priv::SideRows<external, Base>>;
+    using Ordinal = priv::OrdinalType<priv::SourceScan<Universe>::count()>;
+
+    /** Number of values. */
+    static constexpr std::size_t size = priv::SourceScan<Universe>::count();
+
+    /** All the values, sorted. */
+    static constexpr ValueSpan<Value> values()
+    { return priv::SortedValues<Universe, Value>::span(); }
+
+    static constexpr Value value(std::size_t ordinal)
+    { return priv::SortedValues<Universe, Value>::values[ordinal]; }
+
+    /** Ordinal of `value`, or `size` when the mapping does not mention
+     * `value`.
+     */
+    static SEC_CONSTEXPR std::size_t ordinal(Value value) {
+        using Source = priv::OrdinalSource<Universe>;
+        typename Source::Payload result{};
+
+        return priv::SourceLookup<Source>::find(
+                priv::toUnderlying(value), result)
+            ? result : size;
+    }
+};
+
+template <typename Converter, typename Side>
+constexpr std::size_t EnumDomain<Converter, Side>::size;
+
+namespace priv {
+
+/** Ordinal in the domain of `To` of the conversion of each value of the
+ * domain of `From`, or the size of the domain of `To`.
+ */
+template <typename Converter, typename From, typename To>
+struct OrdinalTarget {
+    using FromDomain = EnumDomain<Converter, From>;
+    using ToDomain = EnumDomain<Converter, To>;
+    using Base = typename FromDomain::Base;
+    using Source = ConversionSource<
+        MappingDirection<ToDomain::external, Base>, Base>;
+    using Ordinal = typename ToDomain::Ordinal;
+
+    static_assert(
+        FromDomain::external != ToDomain::external,
+        "Conversion between the two sides of a converter");
+
+    static constexpr Ordinal target(std::size_t ordinal) {
+        return fromEntry(SourceScan<Source>::find(
+            SortedLayout<typename FromDomain::Universe>::key(ordinal)));
+    }
+
+ private:
+    static constexpr Ordinal fromEntry(std::size_t entry) {
+        return static_cast<Ordinal>(entry == Source::size ? ToDomain::size
+            : SourceScan<typename ToDomain::Universe>::countLower(
+                Source::payload(entry)));
+    }
+};
+
+template <
+    typename Converter, typename From, typename To,
+    typename Ordinals = typename MakeIndexSequence<
+        EnumDomain<Converter, From>::size == 0
+            ? 1 : EnumDomain<Converter, From>::size>::Type
+>
+struct OrdinalConversion;
+
+template <
+    typename Converter, typename From, typename To, std::size_t... Ordinals
+>
+struct OrdinalConversion<Converter, From, To, IndexSequence<Ordinals...>> {
+    using Ordinal = typename EnumDomain<Converter, To>::Ordinal;
+
+    static constexpr Ordinal targets[sizeof...(Ordinals)] = {
+        OrdinalTarget<Converter, From, To>::target(Ordinals)...
+    };
+};
+
+template <
+    typename Converter, typename From, typename To, std::size_t... Ordinals
+>
+constexpr typename EnumDomain<Converter, To>::Ordinal
+OrdinalConversion<Converter, From, To, IndexSequence<Ordinals...>>::targets[
+    sizeof...(Ordinals)];
+
+/** Source associating the values which have a conversion to `To` with the
+ * ordinal of their conversion in the domain of `To`.
+ */
+template <typename Converter, typename To>
+struct TargetOrdinalSource {
+    using ToDomain = EnumDomain<Converter, To>;
+    using Base = typename ToDomain::Base;
+    using Conversions = ConversionSource<
+        MappingDirection<ToDomain::external, Base>, Base>;
+
+    using Key = typename Conversions::Key;
+    using Payload = typename ToDomain::Ordinal;
+
+    static constexpr std::size_t size = Conversions::size;
+
+    static constexpr bool has(std::size_t i) { return Conversions::has(i); }
+    static constexpr Key key(std::size_t i) { return Conversions::key(i); }
+
+    static constexpr Payload payload(std::size_t i) {
+        return static_cast<Payload>(
+            SourceScan<typename ToDomain::Universe>::countLower(
+                Conversions::payload(i)));
+    }
+};
+
+/** Ordinal in the domain of `To` of the conversion of any input, looked up
+ * directly from the input.
+ */
+template <typename Converter, typename To>
+struct TargetOrdinal {
+    using Domain = EnumDomain<Converter, To>;
+    using Source = TargetOrdinalSource<Converter, To>;
+    using Input = typename OneDirectionConverter<
+        Domain::external, typename Domain::Base>::Input;
+
+    /** Ordinal of the conversion of `input`, or `Domain::size` when it has
+     * none.
+     */
+    static std::size_t of(Input input) {
+        typename Source::Payload ordinal{};
+        return SourceLookup<Source>::find(toUnderlying(input), ordinal)
+            ? ordinal : Domain::size;
+    }
+
+    /** Whether some input converts to the value of `ordinal`: values only
+     * mentioned by orphans are never reached.
+     */
+    static constexpr bool reached(
+        std::size_t ordinal,
+        std::size_t begin = 0, std::size_t end = Source::size) {
+        return end - begin == 0 ? false
+            : end - begin == 1
+                ? Source::has(begin) && Source::payload(begin) == ordinal
+            : reached(ordinal, begin, begin + (end - begin) / 2)
+                || reached(ordinal, begin + (end - begin) / 2, end);
+    }
+
+    /** Lowest reached ordinal, or `Domain::size` when there is none. */
+    static constexpr std::size_t firstReached(
+        std::size_t begin = 0, std::size_t end = Domain::size) {
+        return end - begin == 0 ? Domain::size
+            : end - begin == 1 ? (reached(begin) ? begin : Domain::size)
+            : firstReached(begin, begin + (end - begin) / 2) != Domain::size
+                ? firstReached(begin, begin + (end - begin) / 2)
+                : firstReached(begin + (end - begin) / 2, end);
+    }
+};
+
+}  // namespace priv
+
+}  // namespace lguim
+
+#endif  // LGUIM_ENUMDOMAIN_H_
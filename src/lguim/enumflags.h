@@ -0,0 +1,311 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_ENUMFLAGS_H_
+#define LGUIM_ENUMFLAGS_H_
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "lguim/enumdomain.h"
+#include "lguim/secureenumconverter_simd.h"
+
+namespace lguim {
+
+/** Conversion of a set of flags. */
+template <typename Output, typename Input>
+struct FlagsResult {
+    using Mask = typename std::make_unsigned<
+        typename std::underlying_type<Input>::type>::type;
+
+    /** Union of the conversions of the bits which have one. */
+    Output flags;
+    /** Bits of the input which have no conversion. */
+    Mask unmapped;
+
+    bool ok() const { return unmapped == 0; }
+};
+
+namespace priv {
+
+/** Conversions of the single bits of the inputs of `Source`. Entries whose
+ * input is not a single bit are left out.
+ */
+template <typename Source>
+struct FlagBits {
+    using Bits = typename std::make_unsigned<typename Source::Key>::type;
+    using OutputBits =
+        typename std::make_unsigned<typename Source::Payload>::type;
+
+    static constexpr std::size_t bitCount = sizeof(Bits) * CHAR_BIT;
+
+    static constexpr Bits bitAt(std::size_t bit)
+    { return static_cast<Bits>(Bits{1} << bit); }
+
+    /** Entry converting `bit`, or `Source::size`. */
+    static constexpr std::size_t entry(std::size_t bit) {
+        return SourceScan<Source>::find(
+            static_cast<typename Source::Key>(bitAt(bit)));
+    }
+
+    static constexpr bool mapped(std::size_t bit)
+    { return entry(bit) != Source::size; }
+
+    /** Conversion of `bit`, zero when it has none. */
+    static constexpr OutputBits of(std::size_t bit) {
+        return mapped(bit)
+            ? static_cast<OutputBits>(Source::payload(entry(bit))) : 0;
+    }
+
+    /** Bits in [begin, end) which have a conversion. */
+    static constexpr Bits mask(
+        std::size_t begin = 0, std::size_t end = bitCount) {
+        return end - begin == 0 ? Bits{0}
+            : end - begin == 1 ? (mapped(begin) ? bitAt(begin) : Bits{0})
+            : static_cast<Bits>(mask(begin, begin + (end - begin) / 2)
+                | mask(begin + (end - begin) / 2, end));
+    }
+
+    /** Union of the conversions of the bits in [begin, end). */
+    static constexpr OutputBits outputMask(
+        std::size_t begin = 0, std::size_t end = bitCount) {
+        return end - begin == 0 ? OutputBits{0}
+            : end - begin == 1 ? of(begin)
+            : static_cast<OutputBits>(
+                outputMask(begin, begin + (end - begin) / 2)
+                    | outputMask(begin + (end - begin) / 2, end));
+    }
+
+    static constexpr std::size_t lowest(Bits bits, std::size_t bit = 0) {
+        return bit == bitCount || (bits & bitAt(bit)) != 0
+            ? bit : lowest(bits, bit + 1);
+    }
+
+    static constexpr std::size_t highest(Bits bits) {
+        return bits == 0 ? 0 : 1 + highest(static_cast<Bits>(bits >> 1));
+    }
+
+    /** Whether the mapped bits from `bit` convert to single bits, higher
+     * than `last` and in the same order as the inputs, so that gathering
+     * them and scattering them to `outputMask` converts.
+     */
+    static constexpr bool ordered(std::size_t bit = 0, OutputBits last = 0) {
+        return bit == bitCount ? true
+            : !mapped(bit) ? ordered(bit + 1, last)
+            : of(bit) > last && (of(bit) & (of(bit) - 1)) == 0
+                && ordered(bit + 1, of(bit));
+    }
+
+    /** Union of the conversions of the bits of `value` in the byte `byte`
+     * of the inputs.
+     */
+    static constexpr OutputBits byteCell(
+        std::size_t byte, std::size_t value, std::size_t bit = 0) {
+        return bit == CHAR_BIT ? OutputBits{0}
+            : static_cast<OutputBits>(
+                (((value >> bit) & 1) != 0
+                    ? of(byte * CHAR_BIT + bit) : OutputBits{0})
+                | byteCell(byte, value, bit + 1));
+    }
+};
+
+/** Layout of the mapped bits of the inputs of `Source`. */
+template <typename Source>
+struct FlagLayout {
+    using Flags = FlagBits<Source>;
+    using OutputBits = typename Flags::OutputBits;
+
+    /** Number of bytes of the inputs up to the last one with a mapped bit,
+     * at least one.
+     */
+    static constexpr std::size_t byteCount =
+        Flags::mask() == 0
+            ? 1 : (Flags::highest(Flags::mask()) + CHAR_BIT - 1) / CHAR_BIT;
+
+    /** Distance from the lowest mapped bit to its conversion. */
+    static constexpr int shift = Flags::mask() == 0 ? 0
+        : static_cast<int>(Flags::highest(
+                Flags::of(Flags::lowest(Flags::mask())))) - 1
+            - static_cast<int>(Flags::lowest(Flags::mask()));
+
+    static constexpr OutputBits shifted(std::size_t bit) {
+        return static_cast<int>(bit) + shift < 0
+                || static_cast<int>(bit) + shift
+                    >= static_cast<int>(sizeof(OutputBits) * CHAR_BIT)
+            ? OutputBits{0}
+            : static_cast<OutputBits>(
+                OutputBits{1} << (static_cast<int>(bit) + shift));
+    }
+
+    /** Whether all the mapped bits in [begin, end) convert to the bit
+     * `shift` places away, so that shifting the input converts.
+     */
+    static constexpr bool shifts(
+        std::size_t begin = 0, std::size_t end = Flags::bitCount) {
+        return end - begin == 0 ? true
+            : end - begin == 1
+                ? !Flags::mapped(begin)
+                    || Flags::of(begin) == shifted(begin)
+            : shifts(begin, begin + (end - begin) / 2)
+                && shifts(begin + (end - begin) / 2, end);
+    }
+};
+
+template <typename Source>
+constexpr std::size_t FlagLayout<Source>::byteCount;
+
+template <typename Source>
+constexpr int FlagLayout<Source>::shift;
+
+/** Conversions of all the values of each byte of the inputs, one table of
+ * 256 entries per byte.
+ */
+template <
+    typename Source,
+    typename Indices = typename MakeIndexSequence<
+        FlagLayout<Source>::byteCount * 256>::Type
+>
+struct FlagTable;
+
+template <typename Source, std::size_t... Indices>
+struct FlagTable<Source, IndexSequence<Indices...>> {
+    using Bits = typename FlagBits<Source>::Bits;
+    using OutputBits = typename FlagBits<Source>::OutputBits;
+
+    static constexpr OutputBits cells[sizeof...(Indices)] = {
+        FlagBits<Source>::byteCell(Indices / 256, Indices % 256)...
+    };
+
+    static OutputBits convert(Bits bits) {
+        OutputBits result = 0;
+
+        // Bytes without mapped bit are skipped at compile time
+        for (std::size_t byte = 0; byte < FlagLayout<Source>::byteCount;
+             ++byte) {
+            if (((FlagBits<Source>::mask() >> (byte * CHAR_BIT)) & 0xff) != 0) {
+                result = static_cast<OutputBits>(result | cells[
+                    byte * 256 + ((bits >> (byte * CHAR_BIT)) & 0xff)]);
+            }
+        }
+
+        return result;
+    }
+};
+
+template <typename Source, std::size_t... Indices>
+constexpr typename FlagBits<Source>::OutputBits
+FlagTable<Source, IndexSequence<Indices...>>::cells[sizeof...(Indices)];
+
+/** Ways to convert the mapped bits of an input. */
+template <typename Source>
+struct FlagKernels {
+    using Bits = typename FlagBits<Source>::Bits;
+    using OutputBits = typename FlagBits<Source>::OutputBits;
+    using Flags = FlagBits<Source>;
+    using Layout = FlagLayout<Source>;
+
+    /** Requires `Layout::shifts()`. */
+    static OutputBits shift(Bits bits) {
+        const Bits mapped = static_cast<Bits>(bits & Flags::mask());
+
+        return Layout::shift >= 0
+            ? static_cast<OutputBits>(
+                static_cast<OutputBits>(mapped) << (Layout::shift & 63))
+            : static_cast<OutputBits>(mapped >> (-Layout::shift & 63));
+    }
+
+    static OutputBits table(Bits bits)
+    { return FlagTable<Source>::convert(bits); }
+
+#if LGUIM_SEC_SIMD_X86
+    /** Requires `Flags::ordered()` and BMI2. */
+    __attribute__((target("bmi2")))
+    static OutputBits pext(Bits bits) {
+        return static_cast<OutputBits>(_pdep_u64(
+            _pext_u64(bits, Flags::mask()), Flags::outputMask()));
+    }
+#endif
+
+    /** The shift when it applies, else gathering and scattering the bits
+     * when they keep their order and BMI2 is enabled at compile time, else
+     * the tables.
+     */
+    static OutputBits convert(Bits bits) {
+#if LGUIM_SEC_SIMD_X86 && defined(__BMI2__)
+        return Layout::shifts() ? shift(bits)
+            : Flags::ordered() ? pext(bits)
+            : table(bits);
+#else
+        return Layout::shifts() ? shift(bits) : table(bits);
+#endif
+    }
+};
+
+template <typename Converter, typename To>
+using FlagSource = ConversionSource<
+    MappingDirection<
+        SideOf<Converter, To>::external, typename Converter::Converter>,
+    typename Converter::Converter>;
+
+}  // namespace priv
+
+/** Converts a set of flags to `ToSide`, which is `side::Internal`,
+ * `side::External` or one of the tags of a `TaggedEnumConverter`. Example:
+ *
+ * ```
+ * #define SEC_MAPPING \
+ *     SEC_EQUIV(Perm::Read, WirePerm::R) \
+ *     SEC_EQUIV(Perm::Write, WirePerm::W) \
+ *     SEC_PROJ_I2E(Perm::Append, WirePerm::W) \
+ *     SEC_ORPHAN_INT(Perm::Admin)
+ *
+ * const auto result = lguim::convertFlags<Converter, lguim::side::External>(
+ *     Perm::Read | Perm::Append | Perm::Admin);
+ * // result.flags == WirePerm::R | WirePerm::W,
+ * // result.unmapped == underlying value of Perm::Admin
+ * ```
+ *
+ * The rows of the mapping between single bits give the conversion of each
+ * bit; rows of values which are not single bits, such as a `None` or a
+ * combination, are left to the conversions of exact values. The result is
+ * the union of the conversions of the bits of `input`, and the bits without
+ * conversion, orphans included, are reported in `unmapped` rather than
+ * failing the whole value.
+ *
+ * The conversion of all the bits at once is chosen at compile time: a
+ * mask and a shift when every bit converts to the bit a constant distance
+ * away, `pext` and `pdep` when the bits keep their order and BMI2 is
+ * enabled (`-mbmi2`, `-march=haswell` or later), and otherwise one lookup
+ * in a table of 256 entries per byte, up to the last byte with a mapped
+ * bit. Like `EnumDomain`, this needs the mapping rows.
+ */
+template <typename Converter, typename ToSide>
+FlagsResult<
+    typename priv::OneDirectionConverter<
+        priv::SideOf<Converter, ToSide>::external,
+        typename Converter::Converter>::Output,
+    typename priv::OneDirectionConverter<
+        priv::SideOf<Converter, ToSide>::external,
+        typename Converter::Converter>::Input>
+convertFlags(typename priv::OneDirectionConverter<
+    priv::SideOf<Converter, ToSide>::external,
+    typename Converter::Converter>::Input input) {
+    using Source = priv::FlagSource<Converter, ToSide>;
+    using Flags = priv::FlagBits<Source>;
+    using Output = typename priv::OneDirectionConverter<
+        priv::SideOf<Converter, ToSide>::external,
+        typename Converter::Converter>::Output;
+
+    const auto bits = static_cast<typename Flags::Bits>(input);
+
+    return {
+        static_cast<Output>(priv::FlagKernels<Source>::convert(bits)),
+        static_cast<typename Flags::Bits>(bits & ~Flags::mask())
+    };
+}
+
+}  // namespace lguim
+
+#endif  // LGUIM_ENUMFLAGS_H_
@@ -0,0 +1,232 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_ENUMHISTOGRAM_H_
+#define LGUIM_ENUMHISTOGRAM_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "lguim/enumdomain.h"
+#include "lguim/enummap.h"
+
+namespace lguim {
+
+namespace priv {
+
+/** Bucket of each input of a conversion to `To`: the ordinal of its
+ * conversion, or the size of the domain when it has none.
+ */
+template <typename Converter, typename To>
+struct TargetBuckets {
+    using Domain = EnumDomain<Converter, To>;
+    using Input = typename TargetOrdinal<Converter, To>::Input;
+
+    /** Buckets of the values, then the one of the values without
+     * conversion.
+     */
+    static constexpr std::size_t count = Domain::size + 1;
+
+    static std::size_t of(Input input)
+    { return TargetOrdinal<Converter, To>::of(input); }
+
+    static std::size_t at(
+        const unsigned char* bytes, std::size_t stride, std::size_t i) {
+        Input input;
+        std::memcpy(&input, bytes + i * stride, sizeof(Input));
+        return of(input);
+    }
+
+    /** Number of inputs in each bucket.
+     *
+     * Consecutive inputs are counted in four histograms, summed at the end:
+     * with a single one, runs of equal values would make each increment wait
+     * for the store of the previous one.
+     */
+    static std::array<std::size_t, count> histogram(
+        const unsigned char* bytes, std::size_t stride, std::size_t size) {
+        constexpr std::size_t lanes = 4;
+        // Inputs counted before the narrow counters are added to the result.
+        constexpr std::size_t blockSize = std::size_t{1} << 30;
+
+        std::array<std::size_t, count> result{};
+        std::uint32_t partial[lanes][count];
+
+        for (std::size_t begin = 0; begin < size; begin += blockSize) {
+            const std::size_t end =
+                size - begin < blockSize ? size : begin + blockSize;
+            std::memset(partial, 0, sizeof(partial));
+
+            std::size_t i = begin;
+            for (; i + lanes <= end; i += lanes) {
+                ++partial[0][at(bytes, stride, i)];
+                ++partial[1][at(bytes, stride, i + 1)];
+                ++partial[2][at(bytes, stride, i + 2)];
+                ++partial[3][at(bytes, stride, i + 3)];
+            }
+            for (; i < end; ++i) {
+                ++partial[0][at(bytes, stride, i)];
+            }
+
+            for (std::size_t bucket = 0; bucket < count; ++bucket) {
+                result[bucket] += std::size_t{partial[0][bucket]}
+                    + partial[1][bucket] + partial[2][bucket]
+                    + partial[3][bucket];
+            }
+        }
+
+        return result;
+    }
+};
+
+/** Type of the values converted to `ToSide`. */
+template <typename Converter, typename ToSide>
+using InputOf = typename TargetBuckets<Converter, ToSide>::Input;
+
+}  // namespace priv
+
+/** Number of values converted to each value of `ToSide`. See
+ * `conversionHistogram`.
+ */
+template <typename Converter, typename ToSide>
+struct ConversionHistogram {
+    using Domain = EnumDomain<Converter, ToSide>;
+
+    /** Number of inputs converted to each value. */
+    EnumMap<Converter, ToSide, std::size_t> counts;
+    /** Number of inputs which have no conversion. */
+    std::size_t invalidCount;
+};
+
+/** Positions of the groups written by `partitionByConversion`.
+ *
+ * The indexes of the inputs converted to each value are consecutive, by
+ * increasing ordinal of the value, followed by the indexes of the inputs
+ * which have no conversion.
+ */
+template <typename Converter, typename ToSide>
+struct ConversionPartition {
+    using Domain = EnumDomain<Converter, ToSide>;
+    using Value = typename Domain::Value;
+
+    /** Position of the group of each ordinal; the group of the inputs
+     * without conversion comes at `Domain::size`, and the last offset is
+     * the number of inputs.
+     */
+    std::array<std::size_t, Domain::size + 2> offsets;
+
+    /** Group of the inputs converted to `value`, which must be mentioned by
+     * the mapping.
+     */
+    std::size_t begin(Value value) const
+    { return offsets[Domain::ordinal(value)]; }
+
+    std::size_t end(Value value) const
+    { return offsets[Domain::ordinal(value) + 1]; }
+
+    std::size_t count(Value value) const { return end(value) - begin(value); }
+
+    std::size_t invalidBegin() const { return offsets[Domain::size]; }
+
+    std::size_t invalidCount() const
+    { return offsets[Domain::size + 1] - offsets[Domain::size]; }
+};
+
+/** Histogram of a field of an array of records, `inputStride` bytes apart,
+ * as in `SecureEnumConverter::toExternalStrided`.
+ */
+template <typename Converter, typename ToSide>
+ConversionHistogram<Converter, ToSide> conversionHistogram(
+    const priv::InputOf<Converter, ToSide>* input, std::size_t inputStride,
+    std::size_t count) {
+    using Buckets = priv::TargetBuckets<Converter, ToSide>;
+
+    const auto buckets = Buckets::histogram(
+        reinterpret_cast<const unsigned char*>(input), inputStride, count);
+
+    ConversionHistogram<Converter, ToSide> result;
+    result.invalidCount = buckets[Buckets::count - 1];
+    for (std::size_t ordinal = 0; ordinal + 1 < Buckets::count; ++ordinal) {
+        result.counts.data()[ordinal] = buckets[ordinal];
+    }
+
+    return result;
+}
+
+/** Counts the `count` values of `input` converted to each value of
+ * `ToSide`, which is `side::Internal`, `side::External` or one of the tags
+ * of a `TaggedEnumConverter`, in one pass. Example:
+ *
+ * ```
+ * auto histogram = lguim::conversionHistogram<Converter, TB>(
+ *     internal.data(), internal.size());
+ * std::size_t b1Count = histogram.counts[B::B1];
+ * ```
+ *
+ * The counters are indexed by the ordinals of `EnumDomain`, looked up
+ * directly from the inputs, so nothing is converted. Like `EnumDomain`,
+ * this needs the mapping rows.
+ */
+template <typename Converter, typename ToSide>
+ConversionHistogram<Converter, ToSide> conversionHistogram(
+    const priv::InputOf<Converter, ToSide>* input, std::size_t count) {
+    return conversionHistogram<Converter, ToSide>(
+        input, sizeof(*input), count);
+}
+
+/** Groups the indexes of the `count` values of `input` by value of their
+ * conversion to `ToSide`, with a counting sort: a histogram pass, then a
+ * pass writing each index to `indexes`, which holds `count` indexes.
+ * Example:
+ *
+ * ```
+ * std::vector<std::size_t> indexes(records.size());
+ * auto partition = lguim::partitionByConversion<Converter, TB>(
+ *     &records[0].status, sizeof(Record), records.size(), indexes.data());
+ * for (std::size_t i = partition.begin(B::B1); i < partition.end(B::B1);
+ *      ++i) {
+ *     process(records[indexes[i]]);
+ * }
+ * ```
+ *
+ * The sort is stable: the indexes of a group are increasing.
+ */
+template <typename Converter, typename ToSide>
+ConversionPartition<Converter, ToSide> partitionByConversion(
+    const priv::InputOf<Converter, ToSide>* input, std::size_t inputStride,
+    std::size_t count, std::size_t* indexes) {
+    using Buckets = priv::TargetBuckets<Converter, ToSide>;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(input);
+
+    const auto buckets = Buckets::histogram(bytes, inputStride, count);
+
+    ConversionPartition<Converter, ToSide> result;
+    std::array<std::size_t, Buckets::count> next;
+    std::size_t offset = 0;
+    for (std::size_t bucket = 0; bucket < Buckets::count; ++bucket) {
+        result.offsets[bucket] = offset;
+        next[bucket] = offset;
+        offset += buckets[bucket];
+    }
+    result.offsets[Buckets::count] = offset;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        indexes[next[Buckets::at(bytes, inputStride, i)]++] = i;
+    }
+
+    return result;
+}
+
+template <typename Converter, typename ToSide>
+ConversionPartition<Converter, ToSide> partitionByConversion(
+    const priv::InputOf<Converter, ToSide>* input, std::size_t count,
+    std::size_t* indexes) {
+    return partitionByConversion<Converter, ToSide>(
+        input, sizeof(*input), count, indexes);
+}
+
+}  // namespace lguim
+
+#endif  // LGUIM_ENUMHISTOGRAM_H_
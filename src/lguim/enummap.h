@@ -0,0 +1,178 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_ENUMMAP_H_
+#define LGUIM_ENUMMAP_H_
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+#include "lguim/enumdomain.h"
+
+namespace lguim {
+
+/** `EnumMap` associates a `T` to each value of one side of a converter,
+ * in an array indexed by the ordinals of `EnumDomain`.
+ *
+ * All the values mentioned by the mapping always have an entry, even if
+ * the underlying values are sparse: the lookup of a key is the computation
+ * of its ordinal, and iteration goes through the array. Example:
+ *
+ * ```
+ * lguim::EnumMap<Converter, lguim::side::Internal, Stats> stats;
+ * ++stats[A::A1].count;
+ * for (auto entry : stats) {
+ *     std::cout << entry.value.count << std::endl;
+ * }
+ * ```
+ */
+template <typename Converter, typename Side, typename T>
+class EnumMap {
+ public:
+    using Domain = EnumDomain<Converter, Side>;
+    using Key = typename Domain::Value;
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = std::size_t;
+
+    /** Element of the iteration: a key and a reference to its value. */
+    template <typename Reference>
+    struct Entry {
+        Key key;
+        Reference value;
+    };
+
+    template <typename Reference>
+    class EntryIterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry<Reference>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Entry<Reference>;
+
+        EntryIterator() : values_(nullptr), ordinal_(0) {}
+
+        EntryIterator(
+            typename std::remove_reference<Reference>::type* values,
+            std::size_t ordinal)
+            : values_(values), ordinal_(ordinal) {}
+
+        /** Conversion of an `iterator` to a `const_iterator`. */
+        template <typename Other, typename = typename std::enable_if<
+            std::is_same<Other, T&>::value
+                && std::is_same<Reference, const T&>::value>::type>
+        EntryIterator(  // NOLINT(runtime/explicit)
+            const EntryIterator<Other>& other)
+            : values_(other.values_), ordinal_(other.ordinal_) {}
+
+        Entry<Reference> operator*() const {
+            return Entry<Reference>{
+                Domain::value(ordinal_), values_[ordinal_]
+            };
+        }
+
+        EntryIterator& operator++() {
+            ++ordinal_;
+            return *this;
+        }
+
+        EntryIterator operator++(int) {
+            EntryIterator previous = *this;
+            ++ordinal_;
+            return previous;
+        }
+
+        bool operator==(const EntryIterator& other) const
+        { return ordinal_ == other.ordinal_; }
+
+        bool operator!=(const EntryIterator& other) const
+        { return ordinal_ != other.ordinal_; }
+
+     private:
+        friend class EntryIterator<const T&>;
+
+        typename std::remove_reference<Reference>::type* values_;
+        std::size_t ordinal_;
+    };
+
+    using iterator = EntryIterator<T&>;
+    using const_iterator = EntryIterator<const T&>;
+
+    /** All the values are value-initialized. */
+    EnumMap() : values_() {}
+
+    explicit EnumMap(const T& value) { values_.fill(value); }
+
+    /** Index of `key` in the array, or `size()` when the mapping does not
+     * mention `key`.
+     */
+    static SEC_CONSTEXPR std::size_t ordinal(Key key)
+    { return Domain::ordinal(key); }
+
+    static constexpr Key key(std::size_t ordinal)
+    { return Domain::value(ordinal); }
+
+    static constexpr std::size_t size() { return Domain::size; }
+
+    /** Value for `key`, which must be mentioned by the mapping. */
+    T& operator[](Key key) { return values_[ordinal(key)]; }
+    const T& operator[](Key key) const { return values_[ordinal(key)]; }
+
+    /** Value for `key`. Throws `std::out_of_range` when the mapping does
+     * not mention `key`.
+     */
+    T& at(Key key) { return values_[checkedOrdinal(key)]; }
+    const T& at(Key key) const { return values_[checkedOrdinal(key)]; }
+
+    /** Value for `key`, or null when the mapping does not mention `key`. */
+    T* find(Key key) {
+        const std::size_t i = ordinal(key);
+        return i == Domain::size ? nullptr : &values_[i];
+    }
+
+    const T* find(Key key) const {
+        const std::size_t i = ordinal(key);
+        return i == Domain::size ? nullptr : &values_[i];
+    }
+
+    void fill(const T& value) { values_.fill(value); }
+
+    /** Values, by increasing ordinal. */
+    T* data() { return values_.data(); }
+    const T* data() const { return values_.data(); }
+
+    iterator begin() { return iterator(values_.data(), 0); }
+    iterator end() { return iterator(values_.data(), Domain::size); }
+
+    const_iterator begin() const
+    { return const_iterator(values_.data(), 0); }
+
+    const_iterator end() const
+    { return const_iterator(values_.data(), Domain::size); }
+
+    friend bool operator==(const EnumMap& lhs, const EnumMap& rhs)
+    { return lhs.values_ == rhs.values_; }
+
+    friend bool operator!=(const EnumMap& lhs, const EnumMap& rhs)
+    { return lhs.values_ != rhs.values_; }
+
+ private:
+    std::size_t checkedOrdinal(Key key) const {
+        const std::size_t i = ordinal(key);
+
+        if (i == Domain::size) {
+            throw std::out_of_range("Key outside of the EnumMap domain");
+        }
+
+        return i;
+    }
+
+    std::array<T, Domain::size> values_;
+};
+
+}  // namespace lguim
+
+#endif  // LGUIM_ENUMMAP_H_
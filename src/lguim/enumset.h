@@ -0,0 +1,286 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_ENUMSET_H_
+#define LGUIM_ENUMSET_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+
+#include "lguim/enumdomain.h"
+
+namespace lguim {
+
+/** `EnumSet` is a set of values of one side of a converter, stored as a
+ * bitset indexed by the ordinals of `EnumDomain`.
+ *
+ * Membership is a lookup of the ordinal and a bit test, and the set
+ * operations work on whole words. Values which are not mentioned by the
+ * mapping cannot be inserted. Example:
+ *
+ * ```
+ * using Allowed = lguim::EnumSet<Converter, lguim::side::Internal>;
+ * Allowed allowed { A::A1, A::A3 };
+ * allowed &= Allowed::convertible();
+ * lguim::EnumSet<Converter, lguim::side::External> external =
+ *     allowed.convert<lguim::side::External>();
+ * ```
+ */
+template <typename Converter, typename Side>
+class EnumSet {
+    using Word = std::uint64_t;
+    static constexpr std::size_t wordBits = 64;
+
+ public:
+    using Domain = EnumDomain<Converter, Side>;
+    using Value = typename Domain::Value;
+    using value_type = Value;
+    using size_type = std::size_t;
+
+    /** Forward iterator on the values, by increasing ordinal. */
+    class const_iterator {
+     public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Value*;
+        using reference = Value;
+
+        const_iterator() : set_(nullptr), ordinal_(0) {}
+
+        const_iterator(const EnumSet* set, std::size_t ordinal)
+            : set_(set), ordinal_(ordinal) {}
+
+        Value operator*() const { return Domain::value(ordinal_); }
+
+        const_iterator& operator++() {
+            ordinal_ = set_->next(ordinal_ + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const
+        { return ordinal_ == other.ordinal_; }
+
+        bool operator!=(const const_iterator& other) const
+        { return ordinal_ != other.ordinal_; }
+
+     private:
+        const EnumSet* set_;
+        std::size_t ordinal_;
+    };
+
+    using iterator = const_iterator;
+
+    constexpr EnumSet() : words_() {}
+
+    EnumSet(std::initializer_list<Value> values) : words_() {
+        for (Value value : values) {
+            insert(value);
+        }
+    }
+
+    /** Set of all the values of the domain. */
+    static EnumSet all() {
+        EnumSet set;
+        for (std::size_t i = 0; i < wordCount; ++i) {
+            set.words_[i] = ~Word{0};
+        }
+        set.trim();
+        return set;
+    }
+
+    /** Set of the values having a conversion, like
+     * `convertibleInternalValues`.
+     */
+    static EnumSet convertible() {
+        EnumSet set;
+        for (Value value : priv::SortedInputs<!Domain::external,
+                                              typename Domain::Base>::span()) {
+            set.insert(value);
+        }
+        return set;
+    }
+
+    bool contains(Value value) const {
+        const std::size_t ordinal = Domain::ordinal(value);
+        return ordinal != Domain::size && test(ordinal);
+    }
+
+    /** Adds `value`. Throws `std::invalid_argument` when the mapping does
+     * not mention `value`.
+     */
+    void insert(Value value) {
+        const std::size_t ordinal = Domain::ordinal(value);
+
+        if (ordinal == Domain::size) {
+            throw std::invalid_argument("Value outside of the EnumSet domain");
+        }
+
+        words_[ordinal / wordBits] |= Word{1} << (ordinal % wordBits);
+    }
+
+    /** Removes `value`, returning the number of removed values. */
+    std::size_t erase(Value value) {
+        const std::size_t ordinal = Domain::ordinal(value);
+
+        if (ordinal == Domain::size || !test(ordinal)) {
+            return 0;
+        }
+
+        words_[ordinal / wordBits] &= ~(Word{1} << (ordinal % wordBits));
+        return 1;
+    }
+
+    void clear() { *this = EnumSet(); }
+
+    std::size_t size() const {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < wordCount; ++i) {
+            count += static_cast<std::size_t>(__builtin_popcountll(words_[i]));
+        }
+        return count;
+    }
+
+    bool empty() const {
+        for (std::size_t i = 0; i < wordCount; ++i) {
+            if (words_[i] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const_iterator begin() const { return const_iterator(this, next(0)); }
+    const_iterator end() const { return const_iterator(this, Domain::size); }
+
+    EnumSet& operator|=(const EnumSet& other) {
+        for (std::size_t i = 0; i < wordCount; ++i) {
+            words_[i] |= other.words_[i];
+        }
+        return *this;
+    }
+
+    EnumSet& operator&=(const EnumSet& other) {
+        for (std::size_t i = 0; i < wordCount; ++i) {
+            words_[i] &= other.words_[i];
+        }
+        return *this;
+    }
+
+    /** Difference. */
+    EnumSet& operator-=(const EnumSet& other) {
+        for (std::size_t i = 0; i < wordCount; ++i) {
+            words_[i] &= ~other.words_[i];
+        }
+        return *this;
+    }
+
+    EnumSet& operator^=(const EnumSet& other) {
+        for (std::size_t i = 0; i < wordCount; ++i) {
+            words_[i] ^= other.words_[i];
+        }
+        return *this;
+    }
+
+    friend EnumSet operator|(EnumSet lhs, const EnumSet& rhs)
+    { return lhs |= rhs; }
+
+    friend EnumSet operator&(EnumSet lhs, const EnumSet& rhs)
+    { return lhs &= rhs; }
+
+    friend EnumSet operator-(EnumSet lhs, const EnumSet& rhs)
+    { return lhs -= rhs; }
+
+    friend EnumSet operator^(EnumSet lhs, const EnumSet& rhs)
+    { return lhs ^= rhs; }
+
+    friend bool operator==(const EnumSet& lhs, const EnumSet& rhs) {
+        for (std::size_t i = 0; i < wordCount; ++i) {
+            if (lhs.words_[i] != rhs.words_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const EnumSet& lhs, const EnumSet& rhs)
+    { return !(lhs == rhs); }
+
+    /** Conversions of the values of the set to the other side of the
+     * converter. Values without conversion are dropped.
+     */
+    template <typename ToSide>
+    EnumSet<Converter, ToSide> convert() const {
+        using Targets = priv::OrdinalConversion<Converter, Side, ToSide>;
+        EnumSet<Converter, ToSide> result;
+
+        for (std::size_t i = 0; i < wordCount; ++i) {
+            for (Word word = words_[i]; word != 0; word &= word - 1) {
+                const std::size_t target = Targets::targets[
+                    i * wordBits
+                    + static_cast<std::size_t>(__builtin_ctzll(word))];
+
+                if (target != EnumDomain<Converter, ToSide>::size) {
+                    result.words_[target / wordBits] |=
+                        Word{1} << (target % wordBits);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    std::set<Value> toSet() const { return std::set<Value>(begin(), end()); }
+
+ private:
+    template <typename, typename>
+    friend class EnumSet;
+
+    static constexpr std::size_t wordCount =
+        Domain::size == 0 ? 1 : (Domain::size + wordBits - 1) / wordBits;
+
+    bool test(std::size_t ordinal) const
+    { return (words_[ordinal / wordBits] >> (ordinal % wordBits)) & 1; }
+
+    /** First ordinal in the set from `ordinal`, or `Domain::size`. */
+    std::size_t next(std::size_t ordinal) const {
+        std::size_t i = ordinal / wordBits;
+        if (i >= wordCount) {
+            return Domain::size;
+        }
+
+        Word word = words_[i] & (~Word{0} << (ordinal % wordBits));
+        while (word == 0) {
+            if (++i == wordCount) {
+                return Domain::size;
+            }
+            word = words_[i];
+        }
+
+        return i * wordBits + static_cast<std::size_t>(__builtin_ctzll(word));
+    }
+
+    /** Clears the bits after the last ordinal. */
+    void trim() {
+        if (Domain::size % wordBits != 0) {
+            words_[wordCount - 1] &=
+                (Word{1} << (Domain::size % wordBits)) - 1;
+        }
+    }
+
+    Word words_[wordCount];
+};
+
+}  // namespace lguim
+
+#endif  // LGUIM_ENUMSET_H_
@@ -0,0 +1,195 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_ENUMVISIT_H_
+#define LGUIM_ENUMVISIT_H_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "lguim/enumdomain.h"
+#include "lguim/enummap.h"
+
+namespace lguim {
+
+/** Value of one side of a converter, as a type: the argument of the
+ * handlers of `visit`. It converts to the value, so a handler taking the
+ * value handles all of them.
+ */
+template <typename Enum, Enum value>
+using EnumConstant = std::integral_constant<Enum, value>;
+
+namespace priv {
+
+constexpr bool allOf() { return true; }
+
+template <typename... Rest>
+constexpr bool allOf(bool first, Rest... rest) {
+    return first && allOf(rest...);
+}
+
+/** Whether `Handler` can be called with `Argument`. */
+template <typename Handler, typename Argument>
+struct Handles {
+    template <typename H>
+    static auto test(int) -> decltype(
+        static_cast<void>(std::declval<H&>()(std::declval<Argument>())),
+        std::true_type());
+
+    template <typename H>
+    static std::false_type test(...);
+
+    static constexpr bool value = decltype(test<Handler>(0))::value;
+};
+
+/** Call of a handler with `Argument`, when the value is `reached`. */
+template <typename Handler, typename Result, typename Argument, bool reached>
+struct VisitCall {
+    static Result call(Handler& handler) { return handler(Argument()); }
+
+    static constexpr Result (*pointer())(Handler&) { return &call; }
+};
+
+template <typename Handler, typename Result, typename Argument>
+struct VisitCall<Handler, Result, Argument, false> {
+    static constexpr Result (*pointer())(Handler&) { return nullptr; }
+};
+
+/** Calls of a handler with each value of the domain of `To`, by ordinal.
+ * Values which no input converts to have no call, so they need no
+ * overload.
+ */
+template <
+    typename Converter, typename To, typename Handler,
+    typename Ordinals = typename MakeIndexSequence<
+        EnumDomain<Converter, To>::size == 0
+            ? 1 : EnumDomain<Converter, To>::size>::Type
+>
+struct VisitCalls;
+
+template <
+    typename Converter, typename To, typename Handler, std::size_t... Ordinals
+>
+struct VisitCalls<Converter, To, Handler, IndexSequence<Ordinals...>> {
+    using Domain = EnumDomain<Converter, To>;
+    using Output = typename Domain::Value;
+    using Targets = TargetOrdinal<Converter, To>;
+
+    static_assert(
+        Targets::firstReached() != Domain::size,
+        "visit: no value converts to this side of the mapping");
+
+    template <std::size_t ordinal>
+    using Constant = EnumConstant<
+        Output, Domain::value(ordinal < Domain::size ? ordinal : 0)>;
+
+    static_assert(
+        allOf((!Targets::reached(Ordinals)
+            || Handles<Handler, Constant<Ordinals>>::value)...),
+        "visit: the handler cannot be called with all the values the "
+        "mapping converts to");
+
+    using Result = decltype(std::declval<Handler&>()(
+        std::declval<Constant<Targets::firstReached()>>()));
+
+    using Call = Result (*)(Handler&);
+
+    static constexpr Call calls[sizeof...(Ordinals)] = {
+        VisitCall<
+            Handler, Result, Constant<Ordinals>, Targets::reached(Ordinals)
+        >::pointer()...
+    };
+};
+
+template <
+    typename Converter, typename To, typename Handler, std::size_t... Ordinals
+>
+constexpr typename VisitCalls<
+    Converter, To, Handler, IndexSequence<Ordinals...>>::Call
+VisitCalls<Converter, To, Handler, IndexSequence<Ordinals...>>::calls[
+    sizeof...(Ordinals)];
+
+}  // namespace priv
+
+/** Calls `handler` with the conversion of `input` to `ToSide`, which is
+ * `side::Internal`, `side::External` or one of the tags of a
+ * `TaggedEnumConverter`, or `orphan` with `input` when it has no
+ * conversion. Example:
+ *
+ * ```
+ * struct Handler {
+ *     int operator()(lguim::EnumConstant<B, B::B1>) { return 1; }
+ *     int operator()(lguim::EnumConstant<B, B::B2>) { return 2; }
+ * };
+ *
+ * int result = lguim::visit<Converter, TB>(
+ *     a, Handler(), [](A) { return 0; });
+ * ```
+ *
+ * This replaces a conversion followed by a `switch` on its result: the
+ * input is looked up once, giving the ordinal of its conversion in
+ * `EnumDomain`, which indexes a table of the calls of `handler`. Each call
+ * passes an `EnumConstant`, so it goes straight to the matching overload.
+ * `handler` must accept all the values the mapping converts to, which is
+ * checked at compile time; values only mentioned by orphans need no
+ * overload. The results of all the calls, orphan included, must convert to
+ * the one of the lowest value.
+ *
+ * Like `EnumDomain`, this needs the mapping rows.
+ */
+template <
+    typename Converter, typename ToSide, typename Handler, typename Orphan
+>
+typename priv::VisitCalls<
+    Converter, ToSide, typename std::remove_reference<Handler>::type
+>::Result visit(
+    typename priv::TargetOrdinal<Converter, ToSide>::Input input,
+    Handler&& handler, Orphan&& orphan) {
+    using Calls = priv::VisitCalls<
+        Converter, ToSide, typename std::remove_reference<Handler>::type>;
+
+    const std::size_t ordinal =
+        priv::TargetOrdinal<Converter, ToSide>::of(input);
+
+    if (ordinal == Calls::Domain::size) {
+        return std::forward<Orphan>(orphan)(input);
+    }
+
+    return Calls::calls[ordinal](handler);
+}
+
+/** Calls the function of `table` for the conversion of `input` to `ToSide`,
+ * or `orphan` with `input` when it has no conversion. The functions take no
+ * argument. Example:
+ *
+ * ```
+ * lguim::EnumMap<Converter, TB, void (*)()> table;
+ * table[B::B1] = &onB1;
+ * table[B::B2] = &onB2;
+ * lguim::visitTable<Converter, TB>(a, table, [](A) {});
+ * ```
+ *
+ * The input is looked up once, giving the index of the function in the
+ * table. See `visit`.
+ */
+template <
+    typename Converter, typename ToSide, typename Function, typename Orphan
+>
+auto visitTable(
+    typename priv::TargetOrdinal<Converter, ToSide>::Input input,
+    const EnumMap<Converter, ToSide, Function>& table, Orphan&& orphan)
+    -> decltype(std::declval<const Function&>()()) {
+    const std::size_t ordinal =
+        priv::TargetOrdinal<Converter, ToSide>::of(input);
+
+    if (ordinal == EnumDomain<Converter, ToSide>::size) {
+        return std::forward<Orphan>(orphan)(input);
+    }
+
+    return table.data()[ordinal]();
+}
+
+}  // namespace lguim
+
+#endif  // LGUIM_ENUMVISIT_H_
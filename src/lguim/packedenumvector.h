@@ -0,0 +1,335 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_PACKEDENUMVECTOR_H_
+#define LGUIM_PACKEDENUMVECTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "lguim/enumdomain.h"
+
+namespace lguim {
+
+namespace priv {
+
+/** Number of bits needed to write the integers lower than `count`. */
+constexpr std::size_t bitWidth(std::size_t count) {
+    return count <= 1 ? 0 : 1 + bitWidth((count + 1) / 2);
+}
+
+}  // namespace priv
+
+/** `PackedEnumVector` is a sequence of values of one side of a converter,
+ * stored as their ordinals in `EnumDomain` on the minimal number of bits.
+ *
+ * A mapping of 3 values uses 2 bits per value, one of 40 values uses 6.
+ * Values which are not mentioned by the mapping cannot be stored. Example:
+ *
+ * ```
+ * lguim::PackedEnumVector<Converter, lguim::side::Internal> events;
+ * events.push_back(A::A1);
+ * lguim::PackedEnumVector<Converter, lguim::side::External> exported =
+ *     events.convert<lguim::side::External>();
+ * ```
+ */
+template <typename Converter, typename Side>
+class PackedEnumVector {
+    using Word = std::uint64_t;
+    static constexpr std::size_t wordBits = 64;
+
+ public:
+    using Domain = EnumDomain<Converter, Side>;
+    using Value = typename Domain::Value;
+    using value_type = Value;
+    using size_type = std::size_t;
+
+    /** Bits used by each value. At least one, to keep the arithmetic
+     * simple for single-value domains.
+     */
+    static constexpr std::size_t bitsPerValue =
+        priv::bitWidth(Domain::size) == 0 ? 1 : priv::bitWidth(Domain::size);
+
+    static_assert(bitsPerValue < wordBits, "Domain too large");
+
+    /** Random access iterator on the values. */
+    class const_iterator {
+     public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Value*;
+        using reference = Value;
+
+        const_iterator() : vector_(nullptr), index_(0) {}
+
+        const_iterator(const PackedEnumVector* vector, std::size_t index)
+            : vector_(vector), index_(index) {}
+
+        Value operator*() const { return (*vector_)[index_]; }
+        Value operator[](difference_type n) const
+        { return (*vector_)[index_ + n]; }
+
+        const_iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+
+        const_iterator& operator--() {
+            --index_;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++index_;
+            return previous;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator previous = *this;
+            --index_;
+            return previous;
+        }
+
+        const_iterator& operator+=(difference_type n) {
+            index_ += n;
+            return *this;
+        }
+
+        const_iterator& operator-=(difference_type n) {
+            index_ -= n;
+            return *this;
+        }
+
+        friend const_iterator operator+(const_iterator it, difference_type n)
+        { return it += n; }
+
+        friend const_iterator operator+(difference_type n, const_iterator it)
+        { return it += n; }
+
+        friend const_iterator operator-(const_iterator it, difference_type n)
+        { return it -= n; }
+
+        friend difference_type operator-(
+            const const_iterator& lhs, const const_iterator& rhs) {
+            return static_cast<difference_type>(lhs.index_)
+                - static_cast<difference_type>(rhs.index_);
+        }
+
+        bool operator==(const const_iterator& other) const
+        { return index_ == other.index_; }
+
+        bool operator!=(const const_iterator& other) const
+        { return index_ != other.index_; }
+
+        bool operator<(const const_iterator& other) const
+        { return index_ < other.index_; }
+
+        bool operator>(const const_iterator& other) const
+        { return index_ > other.index_; }
+
+        bool operator<=(const const_iterator& other) const
+        { return index_ <= other.index_; }
+
+        bool operator>=(const const_iterator& other) const
+        { return index_ >= other.index_; }
+
+     private:
+        const PackedEnumVector* vector_;
+        std::size_t index_;
+    };
+
+    using iterator = const_iterator;
+
+    PackedEnumVector() : words_(), size_(0) {}
+
+    /** Vector of `count` times `value`. */
+    PackedEnumVector(std::size_t count, Value value) : PackedEnumVector() {
+        const std::size_t ordinal = checkedOrdinal(value);
+        resizeWords(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            write(i, ordinal);
+        }
+        size_ = count;
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /** Bytes used by the storage of the values. */
+    std::size_t storageBytes() const { return words_.size() * sizeof(Word); }
+
+    void reserve(std::size_t count)
+    { words_.reserve(wordsFor(count)); }
+
+    void clear() {
+        words_.clear();
+        size_ = 0;
+    }
+
+    Value operator[](std::size_t index) const
+    { return Domain::value(read(index)); }
+
+    /** Value at `index`. Throws `std::out_of_range` after the end. */
+    Value at(std::size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("PackedEnumVector index out of range");
+        }
+        return (*this)[index];
+    }
+
+    /** Replaces the value at `index`. Throws `std::invalid_argument` when
+     * the mapping does not mention `value`.
+     */
+    void set(std::size_t index, Value value)
+    { write(index, checkedOrdinal(value)); }
+
+    /** Appends `value`. Throws `std::invalid_argument` when the mapping
+     * does not mention `value`.
+     */
+    void push_back(Value value) {
+        const std::size_t ordinal = checkedOrdinal(value);
+        resizeWords(size_ + 1);
+        write(size_, ordinal);
+        ++size_;
+    }
+
+    /** Appends `count` values. Throws `std::invalid_argument` when the
+     * mapping does not mention one of them, in which case none is added.
+     */
+    void pack(const Value* values, std::size_t count) {
+        resizeWords(size_ + count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t ordinal = Domain::ordinal(values[i]);
+
+            if (ordinal == Domain::size) {
+                resizeWords(size_);
+                clearAfter(size_);
+                throwInvalid();
+            }
+
+            write(size_ + i, ordinal);
+        }
+
+        size_ += count;
+    }
+
+    /** Copies `count` values from `first` to `out`. */
+    void unpack(std::size_t first, std::size_t count, Value* out) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = Domain::value(read(first + i));
+        }
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+    /** Conversions of the values to the other side of the converter,
+     * working on the ordinals. Throws `std::invalid_argument` when a value
+     * has no conversion.
+     */
+    template <typename ToSide>
+    PackedEnumVector<Converter, ToSide> convert() const {
+        using Targets = priv::OrdinalConversion<Converter, Side, ToSide>;
+        using Result = PackedEnumVector<Converter, ToSide>;
+        Result result;
+        result.resizeWords(size_);
+
+        for (std::size_t i = 0; i < size_; ++i) {
+            const std::size_t target = Targets::targets[read(i)];
+
+            if (target == Result::Domain::size) {
+                std::ostringstream oss;
+                oss << "No conversion for the value at index " << i;
+                throw std::invalid_argument(oss.str());
+            }
+
+            result.write(i, target);
+        }
+
+        result.size_ = size_;
+        return result;
+    }
+
+    friend bool operator==(
+        const PackedEnumVector& lhs, const PackedEnumVector& rhs)
+    { return lhs.size_ == rhs.size_ && lhs.words_ == rhs.words_; }
+
+    friend bool operator!=(
+        const PackedEnumVector& lhs, const PackedEnumVector& rhs)
+    { return !(lhs == rhs); }
+
+ private:
+    template <typename, typename>
+    friend class PackedEnumVector;
+
+    static constexpr Word mask = (Word{1} << bitsPerValue) - 1;
+
+    static std::size_t wordsFor(std::size_t count)
+    { return (count * bitsPerValue + wordBits - 1) / wordBits; }
+
+    static std::size_t checkedOrdinal(Value value) {
+        const std::size_t ordinal = Domain::ordinal(value);
+
+        if (ordinal == Domain::size) {
+            throwInvalid();
+        }
+
+        return ordinal;
+    }
+
+    [[noreturn]] static void throwInvalid() {
+        throw std::invalid_argument(
+            "Value outside of the PackedEnumVector domain");
+    }
+
+    /** Unused bits stay null, so that vectors compare word by word. */
+    void resizeWords(std::size_t count) { words_.resize(wordsFor(count), 0); }
+
+    void clearAfter(std::size_t count) {
+        const std::size_t bit = count * bitsPerValue;
+        if (bit % wordBits != 0) {
+            words_[bit / wordBits] &= (Word{1} << (bit % wordBits)) - 1;
+        }
+    }
+
+    std::size_t read(std::size_t index) const {
+        const std::size_t bit = index * bitsPerValue;
+        const std::size_t word = bit / wordBits;
+        const std::size_t shift = bit % wordBits;
+
+        Word value = words_[word] >> shift;
+        if (shift + bitsPerValue > wordBits) {
+            value |= words_[word + 1] << (wordBits - shift);
+        }
+
+        return static_cast<std::size_t>(value & mask);
+    }
+
+    void write(std::size_t index, std::size_t ordinal) {
+        const std::size_t bit = index * bitsPerValue;
+        const std::size_t word = bit / wordBits;
+        const std::size_t shift = bit % wordBits;
+        const Word value = static_cast<Word>(ordinal);
+
+        words_[word] = (words_[word] & ~(mask << shift)) | (value << shift);
+        if (shift + bitsPerValue > wordBits) {
+            const std::size_t written = wordBits - shift;
+            words_[word + 1] = (words_[word + 1] & ~(mask >> written))
+                | (value >> written);
+        }
+    }
+
+    std::vector<Word> words_;
+    std::size_t size_;
+};
+
+}  // namespace lguim
+
+#endif  // LGUIM_PACKEDENUMVECTOR_H_
@@ -0,0 +1,181 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_PARALLELCONVERSION_H_
+#define LGUIM_PARALLELCONVERSION_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "lguim/enumdomain.h"
+
+namespace lguim {
+
+/** Settings of `parallelConvertBatch`. */
+struct ParallelOptions {
+    /** Threads converting the values, the calling one included. Zero
+     * stands for `std::thread::hardware_concurrency()`.
+     */
+    std::size_t threads;
+
+    /** Values converted by a thread before it takes the next chunk. Zero
+     * stands for the number of values held in 64 KiB, so that the inputs
+     * and outputs of a chunk stay in the cache of a core.
+     */
+    std::size_t chunkSize;
+
+    explicit ParallelOptions(
+        std::size_t threadCount = 0, std::size_t valuesPerChunk = 0)
+        : threads(threadCount), chunkSize(valuesPerChunk) {}
+};
+
+namespace priv {
+
+/** Conversion of an array by several threads, each taking the next chunk
+ * of values when done with the previous one.
+ *
+ * The outputs of the chunks are disjoint, and each thread takes chunks of
+ * increasing indexes, so its first invalid value is found in its first
+ * failing chunk: the results merge into the one of a single batch,
+ * whatever the scheduling.
+ */
+template <typename HalfConverter>
+class ParallelBatch {
+    using Input = typename HalfConverter::Input;
+    using Output = typename HalfConverter::Output;
+
+ public:
+    static BatchResult run(
+        const Input* input, std::size_t count, Output* output,
+        const ParallelOptions& options) {
+        const std::size_t chunk = chunkSize(options);
+        const std::size_t chunks = (count + chunk - 1) / chunk;
+        const std::size_t threads = std::min(threadCount(options), chunks);
+
+        if (threads <= 1) {
+            return HalfConverter::convertBatch(input, count, output);
+        }
+
+        ParallelBatch batch(input, count, output, chunk);
+        std::vector<BatchResult> results(threads, BatchResult{0, count});
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+
+        try {
+            for (std::size_t i = 1; i < threads; ++i) {
+                workers.emplace_back(&ParallelBatch::work, &batch, &results[i]);
+            }
+        } catch (const std::system_error&) {
+            // The threads which could be started share the work.
+        }
+
+        batch.work(&results[0]);
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        BatchResult result{0, count};
+        for (const BatchResult& partial : results) {
+            result.invalidCount += partial.invalidCount;
+            result.firstInvalid =
+                std::min(result.firstInvalid, partial.firstInvalid);
+        }
+
+        return result;
+    }
+
+ private:
+    ParallelBatch(
+        const Input* input, std::size_t count, Output* output,
+        std::size_t chunk)
+        : input_(input), count_(count), output_(output), chunk_(chunk),
+          next_(0) {}
+
+    static std::size_t chunkSize(const ParallelOptions& options) {
+        if (options.chunkSize != 0) {
+            return options.chunkSize;
+        }
+
+        const std::size_t valueBytes = sizeof(Input) + sizeof(Output);
+        return (std::size_t{64} << 10) / valueBytes;
+    }
+
+    static std::size_t threadCount(const ParallelOptions& options) {
+        if (options.threads != 0) {
+            return options.threads;
+        }
+
+        const unsigned hardware = std::thread::hardware_concurrency();
+        return hardware == 0 ? 1 : hardware;
+    }
+
+    void work(BatchResult* result) {
+        for (;;) {
+            const std::size_t begin =
+                next_.fetch_add(chunk_, std::memory_order_relaxed);
+            if (begin >= count_) {
+                return;
+            }
+
+            const std::size_t size = std::min(chunk_, count_ - begin);
+            const BatchResult partial = HalfConverter::convertBatch(
+                input_ + begin, size, output_ + begin);
+
+            if (partial.invalidCount != 0 && result->invalidCount == 0) {
+                result->firstInvalid = begin + partial.firstInvalid;
+            }
+            result->invalidCount += partial.invalidCount;
+        }
+    }
+
+    const Input* input_;
+    std::size_t count_;
+    Output* output_;
+    std::size_t chunk_;
+    std::atomic<std::size_t> next_;
+};
+
+}  // namespace priv
+
+/** Converts the `count` values of `input` to `output`, like
+ * `toExternalBatch` and `toInternalBatch`, on several threads.
+ *
+ * `ToSide` is the side of the outputs: `side::Internal` or
+ * `side::External`, or one of the tags of a `TaggedEnumConverter`. The
+ * result is the one of a single batch: the invalid values are counted and
+ * the first one is reported, whatever the number of threads. Example:
+ *
+ * ```
+ * lguim::BatchResult result = lguim::parallelConvertBatch<
+ *     Converter, lguim::side::External>(
+ *         internal.data(), internal.size(), external.data());
+ * ```
+ *
+ * The threads are started by each call and joined before it returns, so
+ * this is worth it for arrays of millions of values. An array fitting in
+ * one chunk is converted by the calling thread alone.
+ */
+template <typename Converter, typename ToSide>
+BatchResult parallelConvertBatch(
+    const typename priv::OneDirectionConverter<
+        priv::SideOf<Converter, ToSide>::external,
+        typename Converter::Converter>::Input* input,
+    std::size_t count,
+    typename priv::OneDirectionConverter<
+        priv::SideOf<Converter, ToSide>::external,
+        typename Converter::Converter>::Output* output,
+    const ParallelOptions& options = ParallelOptions()) {
+    return priv::ParallelBatch<priv::OneDirectionConverter<
+            priv::SideOf<Converter, ToSide>::external,
+            typename Converter::Converter>
+        >::run(input, count, output, options);
+}
+
+}  // namespace lguim
+
+#endif  // LGUIM_PARALLELCONVERSION_H_
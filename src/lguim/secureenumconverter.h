@@ -4,18 +4,84 @@
 #ifndef LGUIM_SECUREENUMCONVERTER_H_
 #define LGUIM_SECUREENUMCONVERTER_H_
 
+#include <cstdint>
+#include <cstring>
 #include <set>
 #include <stdexcept>
 #include <type_traits>
 #include <sstream>
+#include <vector>
 
 #ifndef SEC_OPTIONAL_NS
 #define SEC_OPTIONAL_NS std
 #include <optional>
 #endif
 
+// Specifier given to the conversion functions when the mapping is included
+// with `SEC_INLINE`. The optional type is only guaranteed to be usable in
+// constant expressions starting with C++17.
+#ifndef SEC_CONSTEXPR
+    #if __cplusplus >= 201703L
+        #define SEC_CONSTEXPR constexpr
+    #else
+        #define SEC_CONSTEXPR
+    #endif
+#endif
+
+#include "lguim/secureenumconverter_engines.h"
+#include "lguim/secureenumconverter_values.h"
+
 namespace lguim {
 
+/** Result of the conversion of an array of values. */
+struct BatchResult {
+    /** Number of values which have no conversion. */
+    std::size_t invalidCount;
+    /** Index of the first value which has no conversion, or the number of
+     * values when all were converted.
+     */
+    std::size_t firstInvalid;
+
+    bool ok() const { return invalidCount == 0; }
+};
+
+/** Result of the conversion of a column with a validity bitmap. */
+struct ColumnResult {
+    /** Number of null outputs: null inputs and values which have no
+     * conversion.
+     */
+    std::size_t nullCount;
+    /** Number of non-null inputs which have no conversion. */
+    std::size_t invalidCount;
+    /** Index of the first non-null input which has no conversion, or the
+     * number of values when all were converted.
+     */
+    std::size_t firstInvalid;
+
+    bool ok() const { return invalidCount == 0; }
+};
+
+/** Run of `length` times `value`, in a run-length encoded sequence. */
+template <typename T>
+struct Run {
+    T value;
+    std::size_t length;
+};
+
+/** Result of the conversion of a run-length encoded sequence. */
+struct RunResult {
+    /** Number of runs written to the output. */
+    std::size_t runCount;
+    /** Number of input runs whose value has no conversion. */
+    std::size_t invalidCount;
+    /** Index of the first input run whose value has no conversion, or the
+     * number of input runs when all were converted.
+     */
+    std::size_t firstInvalid;
+
+    bool ok() const { return invalidCount == 0; }
+};
+
 /** `SecureEnumConverter` is a bi-directional enum converter, which
  * needs only one mapping in code to do both directions, and will
  * only compile when the behavior for all values is explicitely
@@ -69,6 +135,33 @@ namespace lguim {
  * included multiple times in the same translation unit, as long as
  * there is only one inclusion for each type in the project.
  *
+ * Alternatively, defining `SEC_INLINE` before the inclusion makes all
+ * the definitions `inline` (and `constexpr` for the conversions, starting
+ * with C++17, unless `SEC_NO_SWITCH_*` is used), so that the
+ * implementation file can be included in the header declaring the
+ * converter, right after its declaration. The conversions are then
+ * visible from every translation unit and can be inlined and folded at
+ * call sites. The mapping must still be written only once, in this header:
+ *
+ * ```
+ * // abconverter.h
+ * #include "lguim/secureenumconverter.h"
+ * enum class A { A1, A2 };
+ * enum class B { B1, B2 };
+ * using Converter = lguim::SecureEnumConverter<A, B>;
+ *
+ * #define SEC_TYPE Converter
+ * #define SEC_INLINE
+ * #define SEC_MAPPING \
+ *     SEC_EQUIV(A::A1, B::B1) \
+ *     SEC_EQUIV(A::A2, B::B2)
+ * #include "lguim/secureenumconverter.inc"
+ * ```
+ *
+ * The code the conversions are lowered to can be chosen by defining
+ * `SEC_ENGINE` before the inclusion. See `lguim::engine` for the available
+ * engines.
+ *
  * The following macros are available for the mapping:
  *
  *   - `SEC_EQUIV` describes a direct equivalence between two values
@@ -94,6 +187,202 @@ struct SecureEnumConverter {
     static const std::set<Internal>& convertibleInternalValues();
     static const std::set<External>& convertibleExternalValues();
 
+    /** Whether `internal` has a conversion, without converting it. When
+     * the mapping rows are available and the convertible values span at
+     * most 4096 underlying values, this is a test in a constant bitmask.
+     */
+    static bool isConvertibleInternal(Internal internal);
+
+    /** Whether `external` has a conversion. See `isConvertibleInternal`. */
+    static bool isConvertibleExternal(External external);
+
+    /** Index of the first of the `count` values which has no conversion,
+     * or `count` when all have one. The search stops at the first invalid
+     * value, and uses vector kernels when the mapping allows.
+     */
+    static std::size_t firstInvalidInternal(
+        const Internal* values, std::size_t count);
+
+    static std::size_t firstInvalidExternal(
+        const External* values, std::size_t count);
+
+    /** Same values as `convertibleInternalValues`, as a sorted array.
+     *
+     * When the mapping rows are available (both types are enumerations and
+     * `SEC_NO_SWITCH_*` is not used), the array is a constant: the call
+     * neither allocates nor checks for the initialization of a static.
+     */
+    static ValueSpan<Internal> convertibleInternalSpan();
+
+    /** Same values as `convertibleExternalValues`, as a sorted array. See
+     * `convertibleInternalSpan`.
+     */
+    static ValueSpan<External> convertibleExternalSpan();
+
+    /** Conversion of a constant to the internal type, evaluated at compile
+     * time. Does not compile when the constant is an orphan.
+     *
+     * The mapping must be visible (through `SEC_INLINE`, or in the
+     * translation unit including `secureenumconverter.inc`), both types must
+     * be enumerations and `SEC_NO_SWITCH_*` must not be used.
+     */
+    template <priv::ConstantParameter<External> external>
+    static constexpr Internal internalOf()
+    { return priv::ConstantConversion<false, Converter, external>::value; }
+
+    /** Conversion of a constant to the external type, evaluated at compile
+     * time. See `internalOf`.
+     */
+    template <priv::ConstantParameter<Internal> internal>
+    static constexpr External externalOf()
+    { return priv::ConstantConversion<true, Converter, internal>::value; }
+
+    /** Converts the `count` values of `input` to `output`. Outputs of the
+     * values which have no conversion are left untouched.
+     *
+     * The conversion code is inlined in the loop, in the translation unit
+     * including `secureenumconverter.inc`.
+     */
+    static BatchResult toInternalBatch(
+        const External* input, std::size_t count, Internal* output);
+
+    static BatchResult toExternalBatch(
+        const Internal* input, std::size_t count, External* output);
+
+    /** Underlying type of the external type, such as read from a message. */
+    using ExternalUnderlying = priv::UnderlyingType<External>;
+
+    /** Conversion of the external value whose underlying value is `raw`,
+     * for integers read from an untrusted source.
+     *
+     * Any value of any integer type is accepted. The result is the
+     * conversion of the external value equal to `raw`, compared as numbers
+     * rather than after converting `raw` to `ExternalUnderlying`, and is
+     * empty for every other integer: negative values of an unsigned
+     * underlying type, values out of the range of `ExternalUnderlying`,
+     * values between the enumerators, and values which have no conversion
+     * (orphans).
+     *
+     * No enumeration is formed from `raw` before it is validated. When the
+     * mapping rows are available, the check and the conversion of an
+     * `ExternalUnderlying` are one lookup without branch: an offset when the
+     * mapping is one, a table of at most 4 KiB covering the range of the
+     * values, or a binary search. Other integer types are first compared to
+     * the range of `ExternalUnderlying`.
+     */
+    template <typename Integer>
+    static SEC_OPTIONAL_NS::optional<Internal> fromUnderlying(Integer raw) {
+        static_assert(
+            std::is_integral<Integer>::value
+                && !std::is_same<Integer, bool>::value,
+            "fromUnderlying: not an integer");
+
+        Internal internal{};
+        const bool found =
+            findUnderlying(static_cast<ExternalUnderlying>(raw), internal)
+                & priv::representable<ExternalUnderlying>(raw);
+
+        return found
+            ? SEC_OPTIONAL_NS::optional<Internal>(internal)
+            : SEC_OPTIONAL_NS::nullopt;
+    }
+
+    /** Converts `count` underlying values with `fromUnderlying`. Outputs of
+     * the values which have no conversion are left untouched.
+     *
+     * When `validity` is not null, the bit of each output in `validity`,
+     * which holds `(count + 7) / 8` bytes, is set when its value has a
+     * conversion, as in `toInternalColumn`. When the mapping rows are
+     * available, the vector kernels of `toInternalBatch` are used when the
+     * mapping fits one, and give these bits with the conversions.
+     */
+    static BatchResult fromUnderlyingBatch(
+        const ExternalUnderlying* raw, std::size_t count, Internal* output,
+        std::uint8_t* validity = nullptr);
+
+    /** Converts `count` values in place: `values` holds external values
+     * before the call, and internal values after it, except for the values
+     * which have no conversion. Both types must be trivially copyable and
+     * have the same size; the values must then be accessed through a
+     * pointer to `Internal`.
+     */
+    static BatchResult toInternalInPlace(External* values, std::size_t count)
+    { return inPlace<false>(values, count); }
+
+    static BatchResult toExternalInPlace(Internal* values, std::size_t count)
+    { return inPlace<true>(values, count); }
+
+    /** Converts the values of a field of an array of records, to a field of
+     * another array of records, or of the same array. `input` and `output`
+     * point to the fields in the first records, and the strides are the
+     * distances in bytes between two records (usually `sizeof` the record).
+     * Example:
+     *
+     * ```
+     * Converter::toExternalStrided(
+     *     &records[0].status, sizeof(Record), records.size(),
+     *     &wire[0].status, sizeof(WireRecord));
+     * ```
+     *
+     * The fields are accessed in place, through `memcpy`, so they may be
+     * unaligned and the output field may be the input one. Fields of types
+     * which are not trivially copyable, such as `std::string`, are accessed
+     * through their type and must be aligned. When both
+     * strides are the sizes of the values, the arrays are contiguous and
+     * this is the batch conversion, with its vector kernels.
+     */
+    static BatchResult toInternalStrided(
+        const External* input, std::size_t inputStride, std::size_t count,
+        Internal* output, std::size_t outputStride);
+
+    static BatchResult toExternalStrided(
+        const Internal* input, std::size_t inputStride, std::size_t count,
+        External* output, std::size_t outputStride);
+
+    /** Converts a column of values with validity bitmaps, as in Apache
+     * Arrow: bit `i % 8` of byte `i / 8` is set when value `i` is not null.
+     *
+     * `inputValidity` may be null when all the inputs are valid. The bit of
+     * each output in `outputValidity`, which holds `(count + 7) / 8` bytes,
+     * is set when its input is valid and has a conversion; the last bits
+     * of the last byte are cleared. Outputs of values which have no
+     * conversion are left untouched, outputs of null inputs are
+     * unspecified.
+     *
+     * The values are converted by blocks of 64 with the batch conversion,
+     * and its vector kernels: a block without invalid value only copies
+     * its input validity.
+     */
+    static ColumnResult toInternalColumn(
+        const External* input, const std::uint8_t* inputValidity,
+        std::size_t count, Internal* output, std::uint8_t* outputValidity);
+
+    static ColumnResult toExternalColumn(
+        const Internal* input, const std::uint8_t* inputValidity,
+        std::size_t count, External* output, std::uint8_t* outputValidity);
+
+    /** Converts a run-length encoded sequence of `count` runs, each value
+     * being converted once whatever the length of its run. Adjacent runs
+     * whose values have the same conversion, as after many-to-one
+     * projections, are merged into one output run, so `output` needs room
+     * for at most `count` runs. Example:
+     *
+     * ```
+     * std::vector<lguim::Run<External>> output(input.size());
+     * lguim::RunResult result = Converter::toExternalRuns(
+     *     input.data(), input.size(), output.data());
+     * output.resize(result.runCount);
+     * ```
+     *
+     * Runs whose value has no conversion are counted and left out of the
+     * output; the runs around them are not merged.
+     */
+    static RunResult toInternalRuns(
+        const Run<External>* input, std::size_t count, Run<Internal>* output);
+
+    static RunResult toExternalRuns(
+        const Run<Internal>* input, std::size_t count, Run<External>* output);
+
     static Internal toInternalOrThrow(External external) {
         const auto& internalOpt = toInternalOpt(external);
 
@@ -120,10 +409,314 @@ struct SecureEnumConverter {
 
  private:
     static const char* converter() { return __PRETTY_FUNCTION__; }
+
+    /** Sets `internal` to the conversion of the external value whose
+     * underlying value is `raw`, and returns whether there is one.
+     * `internal` is left untouched otherwise.
+     */
+    static bool findUnderlying(ExternalUnderlying raw, Internal& internal);
+
+    template <bool toExternal>
+    static BatchResult inPlace(
+        typename std::conditional<toExternal, Internal, External>::type* values,
+        std::size_t count);
 };
 
 namespace priv {
 
+/** Converts an array with a conversion engine. */
+template <typename Engine>
+inline BatchResult convertBatch(
+    const typename Engine::Input* input, std::size_t count,
+    typename Engine::Output* output) {
+    BatchResult result{0, count};
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto converted = Engine::convertOpt(input[i]);
+
+        if (converted) {
+            output[i] = *converted;
+        } else if (result.invalidCount++ == 0) {
+            result.firstInvalid = i;
+        }
+    }
+
+    return result;
+}
+
+/** Lookup of the external values by their underlying values in the rows,
+ * without branch. See `SecureEnumConverter::fromUnderlying`.
+ */
+template <typename Converter>
+struct UnderlyingLookup {
+    using Source = ConversionSource<
+        MappingDirection<false, Converter>, Converter>;
+    using Raw = typename Source::Key;
+    using Internal = typename Converter::Internal;
+
+    static SEC_CONSTEXPR bool find(Raw raw, Internal& internal) {
+        using Bits = typename std::make_unsigned<
+            typename std::underlying_type<Internal>::type>::type;
+
+        typename Source::Payload payload{};
+        const bool found = ProbeLookup<Source>::find(raw, payload);
+
+        // Selected with a mask: compilers turn a conditional assignment
+        // back into a branch
+        const Bits keep = static_cast<Bits>(static_cast<Bits>(found) - 1);
+        internal = static_cast<Internal>(
+            (static_cast<Bits>(payload) & static_cast<Bits>(~keep))
+                | (static_cast<Bits>(internal) & keep));
+        return found;
+    }
+};
+
+/** Same, through the conversion of the external value, when the rows are
+ * not available. Enumerations have a fixed underlying type, so any of its
+ * values is a value of the enumeration.
+ */
+template <typename Converter>
+struct UnderlyingConversion {
+    using Raw = UnderlyingType<typename Converter::External>;
+    using Internal = typename Converter::Internal;
+
+    static bool find(Raw raw, Internal& internal) {
+        const auto converted = Converter::toInternalOpt(
+            static_cast<typename Converter::External>(raw));
+
+        if (converted) {
+            internal = *converted;
+        }
+        return converted.has_value();
+    }
+};
+
+/** Converts an array of underlying values with `Lookup::find`, setting
+ * the bits of the converted values in `validity` when it is not null. The
+ * values are converted by groups of 8, whose bits update the result, so
+ * that a branchless lookup keeps the loop free of mispredictions on
+ * invalid values.
+ */
+template <typename Lookup>
+inline BatchResult findBatch(
+    const typename Lookup::Raw* raw, std::size_t count,
+    typename Lookup::Internal* output, std::uint8_t* validity) {
+    BatchResult result{0, count};
+
+    for (std::size_t begin = 0; begin < count; begin += 8) {
+        const std::size_t size = count - begin < 8 ? count - begin : 8;
+        unsigned bits = 0;
+
+        for (std::size_t i = 0; i < size; ++i) {
+            // The output is always written back, so that it is not a
+            // conditional store
+            typename Lookup::Internal internal = output[begin + i];
+            const unsigned found =
+                Lookup::find(raw[begin + i], internal) ? 1 : 0;
+            output[begin + i] = internal;
+            bits |= found << i;
+        }
+
+        if (validity != nullptr) {
+            validity[begin / 8] = static_cast<std::uint8_t>(bits);
+        }
+
+        // The first invalid value is selected with a mask
+        const unsigned missing = ~bits & ((1u << size) - 1);
+        const std::size_t first =
+            std::size_t{0} - (missing != 0 && result.invalidCount == 0);
+        result.firstInvalid = ((begin + static_cast<std::size_t>(
+                __builtin_ctz(missing | 0x100u))) & first)
+            | (result.firstInvalid & ~first);
+        result.invalidCount +=
+            static_cast<std::size_t>(__builtin_popcount(missing));
+    }
+
+    return result;
+}
+
+/** Index of the first value which has no conversion with an engine. */
+template <typename Engine>
+inline std::size_t firstInvalid(
+    const typename Engine::Input* values, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!Engine::convertOpt(values[i])) {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+/** Reads the field of a record at `bytes`: copied from its bytes when
+ * trivially copyable, as the field may be unaligned in packed records, and
+ * read through its type otherwise.
+ */
+template <typename T>
+inline T readField(const unsigned char* bytes, std::true_type /* trivial */) {
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+template <typename T>
+inline T readField(
+    const unsigned char* bytes, std::false_type /* trivial */) {
+    return *reinterpret_cast<const T*>(bytes);
+}
+
+/** Writes the field of a record at `bytes`. See `readField`. */
+template <typename T>
+inline void writeField(
+    unsigned char* bytes, const T& value, std::true_type /* trivial */) {
+    std::memcpy(bytes, &value, sizeof(T));
+}
+
+template <typename T>
+inline void writeField(
+    unsigned char* bytes, const T& value, std::false_type /* trivial */) {
+    *reinterpret_cast<T*>(bytes) = value;
+}
+
+/** Converts a field of an array of records with a conversion engine. See
+ * `SecureEnumConverter::toExternalStrided`.
+ */
+template <typename Engine, typename HalfConverter>
+inline BatchResult convertStrided(
+    const typename Engine::Input* input, std::size_t inputStride,
+    std::size_t count,
+    typename Engine::Output* output, std::size_t outputStride) {
+    using Input = typename Engine::Input;
+    using Output = typename Engine::Output;
+
+    const std::uintptr_t inputBegin = reinterpret_cast<std::uintptr_t>(input);
+    const std::uintptr_t outputBegin =
+        reinterpret_cast<std::uintptr_t>(output);
+
+    if (inputStride == sizeof(Input) && outputStride == sizeof(Output)
+        && (inputBegin + count * sizeof(Input) <= outputBegin
+            || outputBegin + count * sizeof(Output) <= inputBegin)) {
+        return HalfConverter::convertBatch(input, count, output);
+    }
+
+    const unsigned char* inputBytes =
+        reinterpret_cast<const unsigned char*>(input);
+    unsigned char* outputBytes = reinterpret_cast<unsigned char*>(output);
+    BatchResult result{0, count};
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto converted = Engine::convertOpt(readField<Input>(
+            inputBytes + i * inputStride,
+            std::integral_constant<
+                bool, std::is_trivially_copyable<Input>::value>()));
+
+        if (converted) {
+            writeField<Output>(
+                outputBytes + i * outputStride, *converted,
+                std::integral_constant<
+                    bool, std::is_trivially_copyable<Output>::value>());
+        } else if (result.invalidCount++ == 0) {
+            result.firstInvalid = i;
+        }
+    }
+
+    return result;
+}
+
+/** Converts a column with validity bitmaps. See
+ * `SecureEnumConverter::toExternalColumn`.
+ */
+template <typename Engine, typename HalfConverter>
+inline ColumnResult convertColumn(
+    const typename Engine::Input* input, const std::uint8_t* inputValidity,
+    std::size_t count,
+    typename Engine::Output* output, std::uint8_t* outputValidity) {
+    constexpr std::size_t blockSize = 64;
+    ColumnResult result{0, 0, count};
+
+    for (std::size_t begin = 0; begin < count; begin += blockSize) {
+        const std::size_t size =
+            count - begin < blockSize ? count - begin : blockSize;
+        const std::size_t bytes = (size + 7) / 8;
+        const std::uint64_t all = size == blockSize
+            ? ~std::uint64_t{0} : (std::uint64_t{1} << size) - 1;
+
+        std::uint64_t valid = all;
+        if (inputValidity != nullptr) {
+            valid = 0;
+            for (std::size_t byte = 0; byte < bytes; ++byte) {
+                valid |= std::uint64_t{inputValidity[begin / 8 + byte]}
+                    << (8 * byte);
+            }
+            valid &= all;
+        }
+
+        const BatchResult block = HalfConverter::convertBatch(
+            input + begin, size, output + begin);
+
+        // Values of null inputs may be anything: the block is checked
+        // again when the batch found a value without conversion.
+        if (block.invalidCount != 0) {
+            std::uint64_t converted = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                if (Engine::convertOpt(input[begin + i])) {
+                    converted |= std::uint64_t{1} << i;
+                }
+            }
+
+            const std::uint64_t invalid = valid & ~converted;
+            if (invalid != 0) {
+                if (result.invalidCount == 0) {
+                    result.firstInvalid = begin
+                        + static_cast<std::size_t>(__builtin_ctzll(invalid));
+                }
+                result.invalidCount +=
+                    static_cast<std::size_t>(__builtin_popcountll(invalid));
+            }
+            valid &= converted;
+        }
+
+        result.nullCount += size
+            - static_cast<std::size_t>(__builtin_popcountll(valid));
+        for (std::size_t byte = 0; byte < bytes; ++byte) {
+            outputValidity[begin / 8 + byte] =
+                static_cast<std::uint8_t>(valid >> (8 * byte));
+        }
+    }
+
+    return result;
+}
+
+/** Converts a run-length encoded sequence with a conversion engine. See
+ * `SecureEnumConverter::toExternalRuns`.
+ */
+template <typename Engine>
+inline RunResult convertRuns(
+    const Run<typename Engine::Input>* input, std::size_t count,
+    Run<typename Engine::Output>* output) {
+    RunResult result{0, 0, count};
+    // Output run which the next one may extend
+    Run<typename Engine::Output>* last = nullptr;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto converted = Engine::convertOpt(input[i].value);
+
+        if (!converted) {
+            if (result.invalidCount++ == 0) {
+                result.firstInvalid = i;
+            }
+            last = nullptr;
+        } else if (last != nullptr && last->value == *converted) {
+            last->length += input[i].length;
+        } else {
+            last = &output[result.runCount++];
+            *last = Run<typename Engine::Output>{*converted, input[i].length};
+        }
+    }
+
+    return result;
+}
+
 template <bool toExternal, typename Converter>
 struct OneDirectionConverter;
 
@@ -140,6 +733,40 @@ struct OneDirectionConverter<true, Converter> {
 
     static const std::set<Output>& convertibleValues()
     { return Converter::convertibleExternalValues(); }
+
+    static BatchResult convertBatch(
+        const Input* input, std::size_t count, Output* output)
+    { return Converter::toExternalBatch(input, count, output); }
+
+    static BatchResult convertInPlace(Input* values, std::size_t count)
+    { return Converter::toExternalInPlace(values, count); }
+
+    static BatchResult convertStrided(
+        const Input* input, std::size_t inputStride, std::size_t count,
+        Output* output, std::size_t outputStride) {
+        return Converter::toExternalStrided(
+            input, inputStride, count, output, outputStride);
+    }
+
+    static ColumnResult convertColumn(
+        const Input* input, const std::uint8_t* inputValidity,
+        std::size_t count, Output* output, std::uint8_t* outputValidity) {
+        return Converter::toExternalColumn(
+            input, inputValidity, count, output, outputValidity);
+    }
+
+    static RunResult convertRuns(
+        const Run<Input>* input, std::size_t count, Run<Output>* output)
+    { return Converter::toExternalRuns(input, count, output); }
+
+    static bool isConvertible(Input input)
+    { return Converter::isConvertibleInternal(input); }
+
+    static std::size_t firstInvalid(const Input* values, std::size_t count)
+    { return Converter::firstInvalidInternal(values, count); }
+
+    static ValueSpan<Output> convertibleSpan()
+    { return Converter::convertibleExternalSpan(); }
 };
 
 template <typename Converter>  // To internal
@@ -155,10 +782,88 @@ struct OneDirectionConverter<false, Converter> {
 
     static const std::set<Output>& convertibleValues()
     { return Converter::convertibleInternalValues(); }
+
+    static BatchResult convertBatch(
+        const Input* input, std::size_t count, Output* output)
+    { return Converter::toInternalBatch(input, count, output); }
+
+    static BatchResult convertInPlace(Input* values, std::size_t count)
+    { return Converter::toInternalInPlace(values, count); }
+
+    static BatchResult convertStrided(
+        const Input* input, std::size_t inputStride, std::size_t count,
+        Output* output, std::size_t outputStride) {
+        return Converter::toInternalStrided(
+            input, inputStride, count, output, outputStride);
+    }
+
+    static ColumnResult convertColumn(
+        const Input* input, const std::uint8_t* inputValidity,
+        std::size_t count, Output* output, std::uint8_t* outputValidity) {
+        return Converter::toInternalColumn(
+            input, inputValidity, count, output, outputValidity);
+    }
+
+    static RunResult convertRuns(
+        const Run<Input>* input, std::size_t count, Run<Output>* output)
+    { return Converter::toInternalRuns(input, count, output); }
+
+    static bool isConvertible(Input input)
+    { return Converter::isConvertibleExternal(input); }
+
+    static std::size_t firstInvalid(const Input* values, std::size_t count)
+    { return Converter::firstInvalidExternal(values, count); }
+
+    static ValueSpan<Output> convertibleSpan()
+    { return Converter::convertibleInternalSpan(); }
 };
 
 }  // namespace priv
 
+template <typename InternalType, typename ExternalType, typename Tag>
+template <bool toExternal>
+BatchResult SecureEnumConverter<InternalType, ExternalType, Tag>::inPlace(
+    typename std::conditional<toExternal, Internal, External>::type* values,
+    std::size_t count) {
+    using Input = typename std::conditional<
+        toExternal, Internal, External>::type;
+    using Output = typename std::conditional<
+        toExternal, External, Internal>::type;
+
+    static_assert(
+        sizeof(Input) == sizeof(Output)
+            && std::is_trivially_copyable<Input>::value
+            && std::is_trivially_copyable<Output>::value,
+        "In-place conversion between types of different sizes");
+
+    // The values are converted by chunks, from a copy of the inputs. The
+    // outputs start as a copy too, so that the values which have no
+    // conversion are kept as they are.
+    constexpr std::size_t chunkSize = 256;
+    Input inputs[chunkSize];
+    Output outputs[chunkSize];
+    BatchResult result{0, count};
+
+    for (std::size_t begin = 0; begin < count; begin += chunkSize) {
+        const std::size_t size =
+            count - begin < chunkSize ? count - begin : chunkSize;
+        std::memcpy(inputs, values + begin, size * sizeof(Input));
+        std::memcpy(outputs, values + begin, size * sizeof(Input));
+
+        const BatchResult chunk = priv::OneDirectionConverter<
+            toExternal, Converter>::convertBatch(inputs, size, outputs);
+
+        std::memcpy(values + begin, outputs, size * sizeof(Output));
+
+        if (chunk.invalidCount != 0 && result.invalidCount == 0) {
+            result.firstInvalid = begin + chunk.firstInvalid;
+        }
+        result.invalidCount += chunk.invalidCount;
+    }
+
+    return result;
+}
+
 /** `TaggedEnumConverter` is a subclass of `SecureEnumConverter`, providing a
  * more natural interface to the `SecureEnumConverter` API than the primary
  * one centered around the internal/external terminology.
@@ -232,13 +937,101 @@ struct TaggedEnumConverter:
         return HalfConverter<DirectionTag>::convertOrThrow(input);
     }
 
+    /** Whether `input` has a conversion to `DirectionTag`. See
+     * `SecureEnumConverter::isConvertibleInternal`.
+     */
+    template <typename DirectionTag>
+    static bool isConvertible(Input<DirectionTag> input) {
+        return HalfConverter<DirectionTag>::isConvertible(input);
+    }
+
+    /** See `SecureEnumConverter::firstInvalidInternal`. */
+    template <typename DirectionTag>
+    static std::size_t firstInvalid(
+        const Input<DirectionTag>* values, std::size_t count) {
+        return HalfConverter<DirectionTag>::firstInvalid(values, count);
+    }
+
+    /** See `SecureEnumConverter::toInternalBatch`. */
+    template <typename DirectionTag>
+    static BatchResult convertBatch(
+        const Input<DirectionTag>* input, std::size_t count,
+        Output<DirectionTag>* output) {
+        return HalfConverter<DirectionTag>::convertBatch(input, count, output);
+    }
+
+    /** See `SecureEnumConverter::toInternalInPlace`. */
+    template <typename DirectionTag>
+    static BatchResult convertInPlace(
+        Input<DirectionTag>* values, std::size_t count) {
+        return HalfConverter<DirectionTag>::convertInPlace(values, count);
+    }
+
+    /** See `SecureEnumConverter::toInternalStrided`. */
     template <typename DirectionTag>
-    static std::set<Output<DirectionTag>>
+    static BatchResult convertStrided(
+        const Input<DirectionTag>* input, std::size_t inputStride,
+        std::size_t count,
+        Output<DirectionTag>* output, std::size_t outputStride) {
+        return HalfConverter<DirectionTag>::convertStrided(
+            input, inputStride, count, output, outputStride);
+    }
+
+    /** See `SecureEnumConverter::toInternalColumn`. */
+    template <typename DirectionTag>
+    static ColumnResult convertColumn(
+        const Input<DirectionTag>* input, const std::uint8_t* inputValidity,
+        std::size_t count,
+        Output<DirectionTag>* output, std::uint8_t* outputValidity) {
+        return HalfConverter<DirectionTag>::convertColumn(
+            input, inputValidity, count, output, outputValidity);
+    }
+
+    /** See `SecureEnumConverter::toInternalRuns`. */
+    template <typename DirectionTag>
+    static RunResult convertRuns(
+        const Run<Input<DirectionTag>>* input, std::size_t count,
+        Run<Output<DirectionTag>>* output) {
+        return HalfConverter<DirectionTag>::convertRuns(input, count, output);
+    }
+
+    template <typename DirectionTag>
+    static const std::set<Output<DirectionTag>>&
     convertibleValues() {
         return HalfConverter<DirectionTag>::convertibleValues();
     }
+
+    template <typename DirectionTag>
+    static ValueSpan<Output<DirectionTag>>
+    convertibleSpan() {
+        return HalfConverter<DirectionTag>::convertibleSpan();
+    }
+
+    /** Conversion of a constant, evaluated at compile time. See
+     * `SecureEnumConverter::internalOf`.
+     */
+    template <typename DirectionTag, Input<DirectionTag> input>
+    static constexpr Output<DirectionTag> convertOf() {
+        return priv::ConstantConversion<
+            std::is_same<DirectionTag, ExternalTag>::value,
+            SecureEnumConverter<InternalType, ExternalType, Tag>,
+            input
+        >::value;
+    }
 };
 
+#if __cplusplus >= 201402L
+/** Conversion of a constant with a `TaggedEnumConverter`, evaluated at
+ * compile time, e.g. `lguim::convert_v<Converter, TB, A::A1>`.
+ */
+template <
+    typename Converter, typename DirectionTag,
+    typename Converter::template Input<DirectionTag> input
+>
+constexpr typename Converter::template Output<DirectionTag> convert_v =
+    Converter::template convertOf<DirectionTag, input>();
+#endif
+
 /** `TaggedEnumConverter` is a subclass of `SecureEnumConverter`, providing a
  * more natural interface to the `SecureEnumConverter` API than the primary
  * one centered around the internal/external terminology.
@@ -0,0 +1,1019 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_SECUREENUMCONVERTER_ENGINES_H_
+#define LGUIM_SECUREENUMCONVERTER_ENGINES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace lguim {
+
+/** Engines are the different ways a conversion can be lowered to code.
+ *
+ * The engine is chosen by defining `SEC_ENGINE` to one of the following
+ * types before including `secureenumconverter.inc`:
+ *
+ * ```
+ * #define SEC_TYPE Converter
+ * #define SEC_ENGINE lguim::engine::DenseTable
+ * #define SEC_MAPPING \
+ *     SEC_EQUIV(A::A1, B::B1) \
+ *     SEC_EQUIV(A::A2, B::B2)
+ * #include "lguim/secureenumconverter.inc"
+ * ```
+ *
+ * The default is `Auto` when both types are enumerations, and `Switch`
+ * otherwise or when `SEC_NO_SWITCH_INTERNAL` or `SEC_NO_SWITCH_EXTERNAL` is
+ * defined.
+ *
+ * Whatever the engine, the code generated from `SEC_MAPPING` is always
+ * compiled, so that the compiler still checks the mapping is exhaustive.
+ *
+ * Engines other than `Switch` need both types to be enumerations, and can
+ * therefore not be used with `SEC_NO_SWITCH_INTERNAL` or
+ * `SEC_NO_SWITCH_EXTERNAL`.
+ */
+namespace engine {
+
+/** Uses the code generated from `SEC_MAPPING`: a `switch`, or a chain of
+ * comparisons when `SEC_NO_SWITCH_INTERNAL`/`SEC_NO_SWITCH_EXTERNAL` is
+ * defined.
+ */
+struct Switch {};
+
+/** Uses, for each direction, an array indexed by the underlying value of
+ * the input, spanning from the smallest to the largest convertible input.
+ * A conversion is a bounds check and a load.
+ *
+ * The table is limited to 65536 entries.
+ *
+ * Orphans and values absent from the mapping are marked with a sentinel,
+ * which must be a value of the output underlying type not used by any
+ * output: either one more than the largest output or one less than the
+ * smallest.
+ */
+struct DenseTable {};
+
+/** Uses, for each direction, the sorted array of the convertible inputs,
+ * searched with a branchless binary search, and the parallel array of the
+ * outputs. Fits enumerations whose values are far apart, like protocol
+ * codes, where a dense table would be mostly empty.
+ *
+ * For `n` convertible inputs, the tables use `n * (sizeof(Input) +
+ * sizeof(Output))` bytes and a conversion reads `ceil(log2(n)) + 1` keys,
+ * with no data-dependent branch but the final comparison.
+ */
+struct SortedKeys {};
+
+/** Computes each output by adding a constant to the underlying value of the
+ * input, after checking the input is in the range of convertible values.
+ * Identity mappings, where values have the same underlying value on both
+ * sides, are a special case where the constant is zero.
+ *
+ * Only available when the convertible inputs form a range with no gap (no
+ * orphan) and all the outputs are at the same distance from their input.
+ */
+struct Offset {};
+
+/** Same as `DenseTable`, for mappings whose convertible inputs form a range
+ * with no gap (no orphan), so that there is no sentinel to check.
+ */
+struct Permutation {};
+
+/** Detects the shape of the mapping and selects, for each direction:
+ *
+ *   - `Offset` when it is available;
+ *   - `Permutation` when it is available and the table fits in 1 KiB;
+ *   - `DenseTable` when the table fits in 1 KiB and at least one cell out
+ *     of four is a convertible value;
+ *   - `SortedKeys` when there are at least 8 convertible values;
+ *   - `Switch` otherwise, where the compiler usually generates a few
+ *     comparisons.
+ *
+ * `EngineReport` tells which engine was selected.
+ */
+struct Auto {};
+
+}  // namespace engine
+
+enum class EngineKind { Switch, DenseTable, SortedKeys, Offset, Permutation };
+
+/** Description of the engine used for one conversion direction. */
+struct EngineDescriptor {
+    EngineKind kind;
+    /** Number of convertible input values. */
+    std::size_t entries;
+    /** Size of the static tables used by the engine. Zero for `Switch`,
+     * whose tables are up to the compiler.
+     */
+    std::size_t tableBytes;
+};
+
+/** Engines used by a converter, e.g. to audit the memory used by the
+ * converters of a program:
+ *
+ * ```
+ * static_assert(
+ *     lguim::EngineReport<Converter>::toExternal().tableBytes <= 64,
+ *     "Converter tables do not fit in a cache line");
+ * ```
+ *
+ * The mapping must be visible (through `SEC_INLINE`, or in the translation
+ * unit including `secureenumconverter.inc`) and both types must be
+ * enumerations.
+ */
+template <typename Converter>
+struct EngineReport;
+
+namespace priv {
+
+enum class RowKind { Equiv, ProjI2E, ProjE2I, OrphanInt, OrphanExt };
+
+template <typename Internal, typename External>
+struct MappingRow {
+    RowKind kind;
+    Internal internal;
+    External external;
+};
+
+/** Whether both types of `Converter` are enumerations, which the mapping
+ * rows and the engines other than `Switch` need.
+ */
+template <typename Converter>
+struct EnumSides : std::integral_constant<bool,
+    std::is_enum<typename Converter::Internal>::value
+        && std::is_enum<typename Converter::External>::value> {};
+
+/** Engine used when `SEC_ENGINE` is not defined. */
+template <typename Converter>
+using DefaultEngine = typename std::conditional<
+    EnumSides<Converter>::value, engine::Auto, engine::Switch
+>::type;
+
+/** Compile-time copy of `SEC_MAPPING`.
+ *
+ * Specialized by `secureenumconverter.inc` when both types are enumerations,
+ * with a static member `rows`, an array of `MappingRow`, and the type
+ * `Engine`, the engine given with `SEC_ENGINE`. The specialization is
+ * written for `enumSides` true only, so that it is never instantiated for
+ * other types. The last parameter only exists to make the specialization a
+ * template, so that it can be defined in a header.
+ */
+template <
+    typename Converter, bool enumSides = EnumSides<Converter>::value,
+    typename = void
+>
+struct Mapping;
+
+/** Code generated from `SEC_MAPPING`, as a `switch` or a chain of `if`.
+ *
+ * Specialized by `secureenumconverter.inc`.
+ */
+template <typename Converter>
+struct SwitchConverter {
+    using Internal = typename Converter::Internal;
+    using External = typename Converter::External;
+
+    static SEC_OPTIONAL_NS::optional<Internal> toInternalOpt(External);
+    static SEC_OPTIONAL_NS::optional<External> toExternalOpt(Internal);
+};
+
+/** Reads the rows of `Mapping<Converter>` for one conversion direction. */
+template <bool toExternal, typename Converter>
+struct MappingDirection;
+
+template <typename Converter>  // To external
+struct MappingDirection<true, Converter> {
+    using Input = typename Converter::Internal;
+    using Output = typename Converter::External;
+    using Row = MappingRow<Input, Output>;
+
+    static SEC_CONSTEXPR SEC_OPTIONAL_NS::optional<Output>
+    switchOpt(Input input)
+    { return SwitchConverter<Converter>::toExternalOpt(input); }
+
+    static constexpr bool converts(const Row& row)
+    { return row.kind == RowKind::Equiv || row.kind == RowKind::ProjI2E; }
+
+    static constexpr Input input(const Row& row) { return row.internal; }
+    static constexpr Output output(const Row& row) { return row.external; }
+};
+
+template <typename Converter>  // To internal
+struct MappingDirection<false, Converter> {
+    using Input = typename Converter::External;
+    using Output = typename Converter::Internal;
+    using Row = MappingRow<Output, Input>;
+
+    static SEC_CONSTEXPR SEC_OPTIONAL_NS::optional<Output>
+    switchOpt(Input input)
+    { return SwitchConverter<Converter>::toInternalOpt(input); }
+
+    static constexpr bool converts(const Row& row)
+    { return row.kind == RowKind::Equiv || row.kind == RowKind::ProjE2I; }
+
+    static constexpr Input input(const Row& row) { return row.external; }
+    static constexpr Output output(const Row& row) { return row.internal; }
+};
+
+template <typename Enum>
+constexpr typename std::underlying_type<Enum>::type toUnderlying(Enum value) {
+    return static_cast<typename std::underlying_type<Enum>::type>(value);
+}
+
+/** Integer lookup described by the conversions of one direction.
+ *
+ * Engines work on such sources: `size` candidate entries, among which
+ * those for which `has` is true associate `key` to `payload`. Keys of the
+ * present entries are unique.
+ */
+template <typename Direction, typename Converter>
+struct ConversionSource {
+    using Key = typename std::underlying_type<
+        typename Direction::Input>::type;
+    using Payload = typename std::underlying_type<
+        typename Direction::Output>::type;
+
+    static constexpr std::size_t size =
+        sizeof(Mapping<Converter>::rows) / sizeof(Mapping<Converter>::rows[0]);
+
+    static constexpr bool has(std::size_t i)
+    { return Direction::converts(Mapping<Converter>::rows[i]); }
+
+    static constexpr Key key(std::size_t i)
+    { return toUnderlying(Direction::input(Mapping<Converter>::rows[i])); }
+
+    static constexpr Payload payload(std::size_t i)
+    { return toUnderlying(Direction::output(Mapping<Converter>::rows[i])); }
+};
+
+/** Compile-time statistics on a source.
+ *
+ * Written as C++11 constexpr functions. Scans split their range in two
+ * halves, so that the recursion depth stays logarithmic.
+ */
+template <typename Source>
+struct SourceScan {
+    using Key = typename Source::Key;
+    using Payload = typename Source::Payload;
+
+    static constexpr std::size_t count(
+        std::size_t begin = 0, std::size_t end = Source::size) {
+        return end - begin == 0 ? 0
+            : end - begin == 1 ? (Source::has(begin) ? 1 : 0)
+            : count(begin, begin + (end - begin) / 2)
+                + count(begin + (end - begin) / 2, end);
+    }
+
+    /** Index of the present entry for `key`, or `Source::size`. */
+    static constexpr std::size_t find(
+        Key key, std::size_t begin = 0, std::size_t end = Source::size) {
+        return end - begin == 0 ? Source::size
+            : end - begin == 1
+                ? (Source::has(begin) && Source::key(begin) == key
+                    ? begin : Source::size)
+            : firstFound(find(key, begin, begin + (end - begin) / 2),
+                         find(key, begin + (end - begin) / 2, end));
+    }
+
+    /** Number of present entries whose key is lower than the one of
+     * `entry`, or `Source::size` if `entry` is not present.
+     */
+    static constexpr std::size_t rank(std::size_t entry) {
+        return Source::has(entry)
+            ? countLower(Source::key(entry)) : Source::size;
+    }
+
+    static constexpr std::size_t countLower(
+        Key key, std::size_t begin = 0, std::size_t end = Source::size) {
+        return end - begin == 0 ? 0
+            : end - begin == 1
+                ? (Source::has(begin) && Source::key(begin) < key ? 1 : 0)
+            : countLower(key, begin, begin + (end - begin) / 2)
+                + countLower(key, begin + (end - begin) / 2, end);
+    }
+
+    static constexpr Key minKey(
+        std::size_t begin = 0, std::size_t end = Source::size) {
+        return end - begin == 0 ? std::numeric_limits<Key>::max()
+            : end - begin == 1
+                ? (Source::has(begin)
+                    ? Source::key(begin) : std::numeric_limits<Key>::max())
+            : lesser(minKey(begin, begin + (end - begin) / 2),
+                     minKey(begin + (end - begin) / 2, end));
+    }
+
+    static constexpr Key maxKey(
+        std::size_t begin = 0, std::size_t end = Source::size) {
+        return end - begin == 0 ? std::numeric_limits<Key>::lowest()
+            : end - begin == 1
+                ? (Source::has(begin)
+                    ? Source::key(begin) : std::numeric_limits<Key>::lowest())
+            : greater(maxKey(begin, begin + (end - begin) / 2),
+                      maxKey(begin + (end - begin) / 2, end));
+    }
+
+    static constexpr Payload minPayload(
+        std::size_t begin = 0, std::size_t end = Source::size) {
+        return end - begin == 0 ? std::numeric_limits<Payload>::max()
+            : end - begin == 1
+                ? (Source::has(begin)
+                    ? Source::payload(begin)
+                    : std::numeric_limits<Payload>::max())
+            : lesser(minPayload(begin, begin + (end - begin) / 2),
+                     minPayload(begin + (end - begin) / 2, end));
+    }
+
+    static constexpr Payload maxPayload(
+        std::size_t begin = 0, std::size_t end = Source::size) {
+        return end - begin == 0 ? std::numeric_limits<Payload>::lowest()
+            : end - begin == 1
+                ? (Source::has(begin)
+                    ? Source::payload(begin)
+                    : std::numeric_limits<Payload>::lowest())
+            : greater(maxPayload(begin, begin + (end - begin) / 2),
+                      maxPayload(begin + (end - begin) / 2, end));
+    }
+
+ private:
+    static constexpr std::size_t firstFound(std::size_t a, std::size_t b)
+    { return a != Source::size ? a : b; }
+
+    template <typename T>
+    static constexpr T lesser(T a, T b) { return b < a ? b : a; }
+
+    template <typename T>
+    static constexpr T greater(T a, T b) { return a < b ? b : a; }
+};
+
+/** Type of the template parameter of the constant conversions.
+ *
+ * Only enumerations have compile-time conversions. Other types are
+ * replaced by a type without values, so that the declarations stay valid.
+ */
+enum class NoConstant {};
+
+template <typename T>
+using ConstantParameter =
+    typename std::conditional<std::is_enum<T>::value, T, NoConstant>::type;
+
+template <typename T>
+struct TypeIdentity { using type = T; };
+
+/** Underlying type of an enumeration. Other types are kept, so that the
+ * declarations stay valid.
+ */
+template <typename T>
+using UnderlyingType = typename std::conditional<
+    std::is_enum<T>::value, std::underlying_type<T>, TypeIdentity<T>
+>::type::type;
+
+template <typename T>
+constexpr bool isNegative(T value, std::true_type /* signed */)
+{ return value < T{0}; }
+
+template <typename T>
+constexpr bool isNegative(T, std::false_type /* signed */) { return false; }
+
+/** Whether the integer `value` is a value of `To`, so that converting it to
+ * `To` keeps it. Both tests are evaluated, without branch.
+ */
+template <typename To, typename From>
+constexpr bool representable(From value) {
+    return (static_cast<From>(static_cast<To>(value)) == value)
+        & (isNegative(value, std::is_signed<From>())
+            == isNegative(static_cast<To>(value), std::is_signed<To>()));
+}
+
+/** Conversion of a constant, evaluated at compile time from the rows. */
+template <
+    bool toExternal, typename Converter,
+    typename MappingDirection<toExternal, Converter>::Input input
+>
+struct ConstantConversion {
+    using Direction = MappingDirection<toExternal, Converter>;
+    using Source = ConversionSource<Direction, Converter>;
+
+    static constexpr std::size_t entry =
+        SourceScan<Source>::find(toUnderlying(input));
+
+    static_assert(
+        entry != Source::size,
+        "The constant has no conversion in this direction of the mapping");
+
+    // The first row is only read after the assertion above failed, to avoid
+    // a second error for the out-of-range index.
+    static constexpr typename Direction::Output value =
+        static_cast<typename Direction::Output>(
+            Source::payload(entry != Source::size ? entry : 0));
+};
+
+template <std::size_t... Indices>
+struct IndexSequence {};
+
+template <typename First, typename Second>
+struct ConcatIndexSequences;
+
+template <std::size_t... First, std::size_t... Second>
+struct ConcatIndexSequences<
+    IndexSequence<First...>, IndexSequence<Second...>> {
+    using Type = IndexSequence<First..., (sizeof...(First) + Second)...>;
+};
+
+/** Equivalent of C++14 `std::make_index_sequence`, with a logarithmic
+ * instantiation depth.
+ */
+template <std::size_t N>
+struct MakeIndexSequence {
+    using Type = typename ConcatIndexSequences<
+        typename MakeIndexSequence<N / 2>::Type,
+        typename MakeIndexSequence<N - N / 2>::Type
+    >::Type;
+};
+
+template <>
+struct MakeIndexSequence<0> { using Type = IndexSequence<>; };
+
+template <>
+struct MakeIndexSequence<1> { using Type = IndexSequence<0>; };
+
+/** Range of the keys of a source, from the lowest to the highest present
+ * one.
+ */
+template <typename Source>
+struct KeyRange {
+    using Key = typename Source::Key;
+    using UnsignedKey = typename std::make_unsigned<Key>::type;
+    using Scan = SourceScan<Source>;
+
+    static constexpr Key first = Scan::minKey();
+
+    // Computed on unsigned values: the difference always fits. Zero when
+    // there is no key, or when they span the whole `std::size_t` range.
+    static constexpr std::size_t span = Scan::count() == 0 ? 0
+        : static_cast<UnsignedKey>(
+              static_cast<UnsignedKey>(Scan::maxKey())
+                  - static_cast<UnsignedKey>(first)) + std::size_t{1};
+
+    /** Whether all the keys of the range are present. */
+    static constexpr bool complete = span != 0 && span == Scan::count();
+
+    static constexpr Key keyAt(std::size_t offset) {
+        return static_cast<Key>(
+            static_cast<UnsignedKey>(
+                static_cast<UnsignedKey>(first) + offset));
+    }
+
+    /** Offset of `key` in the range. Keys out of the range give an offset
+     * greater than or equal to `span`.
+     */
+    static constexpr std::size_t offsetOf(Key key) {
+        return static_cast<UnsignedKey>(
+            static_cast<UnsignedKey>(key) - static_cast<UnsignedKey>(first));
+    }
+};
+
+/** Choice of a payload value marking absent keys, which must not be the
+ * payload of any present entry: either one more than the highest payload
+ * or one less than the lowest.
+ */
+template <typename Source>
+struct PayloadSentinel {
+    using Payload = typename Source::Payload;
+    using Scan = SourceScan<Source>;
+
+    static constexpr bool aboveMax = Scan::count() == 0
+        || Scan::maxPayload() < std::numeric_limits<Payload>::max();
+    static constexpr bool belowMin =
+        Scan::minPayload() > std::numeric_limits<Payload>::lowest();
+
+    static constexpr bool available = aboveMax || belowMin;
+
+    static constexpr Payload value = Scan::count() == 0 ? Payload{0}
+        : aboveMax ? static_cast<Payload>(Scan::maxPayload() + 1)
+        : static_cast<Payload>(Scan::minPayload() - 1);
+};
+
+/** Layout of the table built by the `DenseTable` and `Permutation`
+ * engines.
+ */
+template <typename Source>
+struct DenseTableLayout : KeyRange<Source> {
+    using Key = typename Source::Key;
+    using Payload = typename Source::Payload;
+    using Range = KeyRange<Source>;
+    using Scan = SourceScan<Source>;
+
+    static constexpr std::size_t maxSpan = std::size_t{1} << 16;
+
+    static_assert(
+        Scan::count() == 0 || (Range::span != 0 && Range::span <= maxSpan),
+        "DenseTable engine: the input values are too far apart");
+
+    // Size of the array: never empty, and not blowing up the compiler when
+    // the assertion above fails.
+    static constexpr std::size_t tableSize =
+        Range::span == 0 || Range::span > maxSpan ? 1 : Range::span;
+
+    static_assert(
+        Range::complete || PayloadSentinel<Source>::available,
+        "DenseTable engine: the outputs use all the values of their "
+        "underlying type, there is no room for a sentinel");
+
+    // Unused when the range is complete.
+    static constexpr Payload sentinel = PayloadSentinel<Source>::value;
+
+    static constexpr Payload cell(std::size_t offset) {
+        return Scan::find(Range::keyAt(offset)) == Source::size
+            ? sentinel : Source::payload(Scan::find(Range::keyAt(offset)));
+    }
+};
+
+/** Detection of mappings which are simple arithmetic functions. */
+template <typename Source>
+struct SourceShape {
+    using Range = KeyRange<Source>;
+    using Scan = SourceScan<Source>;
+
+    // Outputs are computed modulo 2^N, which gives the same result on the
+    // width of the payload whatever the signedness of both types.
+    using Wide = unsigned long long;
+
+    static constexpr Wide delta(std::size_t entry) {
+        return static_cast<Wide>(Source::payload(entry))
+            - static_cast<Wide>(Source::key(entry));
+    }
+
+    static constexpr bool sameDelta(
+        Wide expected, std::size_t begin = 0, std::size_t end = Source::size) {
+        return end - begin == 0 ? true
+            : end - begin == 1
+                ? !Source::has(begin) || delta(begin) == expected
+            : sameDelta(expected, begin, begin + (end - begin) / 2)
+                && sameDelta(expected, begin + (end - begin) / 2, end);
+    }
+
+    /** Value to add to the inputs, when `affine`. */
+    static constexpr Wide offset =
+        Range::complete ? delta(Scan::find(Range::first)) : 0;
+
+    static constexpr bool affine = Range::complete && sameDelta(offset);
+};
+
+template <typename Source>
+struct OffsetLookup {
+    using Range = KeyRange<Source>;
+    using Shape = SourceShape<Source>;
+    using Key = typename Source::Key;
+    using Payload = typename Source::Payload;
+
+    static_assert(
+        Shape::affine,
+        "Offset engine: the mapping is not a constant offset on a range of "
+        "values");
+
+    static SEC_CONSTEXPR bool find(Key key, Payload& payload) {
+        payload = static_cast<Payload>(
+            static_cast<typename Shape::Wide>(key) + Shape::offset);
+        return Range::offsetOf(key) < Range::span;
+    }
+
+    static constexpr std::size_t tableBytes() { return 0; }
+};
+
+template <
+    typename Source,
+    typename Indices = typename MakeIndexSequence<
+        DenseTableLayout<Source>::tableSize>::Type
+>
+struct DenseTable;
+
+template <typename Source, std::size_t... Offsets>
+struct DenseTable<Source, IndexSequence<Offsets...>> {
+    using Layout = DenseTableLayout<Source>;
+    using Key = typename Source::Key;
+    using Payload = typename Source::Payload;
+
+    static constexpr Payload cells[sizeof...(Offsets)] = {
+        Layout::cell(Offsets)...
+    };
+
+    static SEC_CONSTEXPR bool find(Key key, Payload& payload) {
+        const std::size_t offset = Layout::offsetOf(key);
+
+        if (offset >= Layout::span) {
+            return false;
+        }
+
+        payload = cells[offset];
+        return Layout::complete || payload != Layout::sentinel;
+    }
+
+    static constexpr std::size_t tableBytes() { return sizeof(cells); }
+};
+
+template <typename Source, std::size_t... Offsets>
+constexpr typename Source::Payload
+DenseTable<Source, IndexSequence<Offsets...>>::cells[sizeof...(Offsets)];
+
+template <typename Source>
+using DenseTableLookup = DenseTable<Source>;
+
+/** Layout of the bitmask of the keys of a source, over its key range. It
+ * is used for sources spanning at most `maxSpan` keys (512 bytes).
+ */
+template <typename Source>
+struct KeyMaskLayout : KeyRange<Source> {
+    using Range = KeyRange<Source>;
+
+    static constexpr std::size_t maxSpan = 4096;
+    static constexpr std::size_t wordBits = 64;
+
+    static constexpr bool usable = Range::span != 0 && Range::span <= maxSpan;
+
+    static constexpr std::size_t wordCount =
+        usable ? (Range::span + wordBits - 1) / wordBits : 1;
+
+    static constexpr bool present(std::size_t offset) {
+        return usable && offset < Range::span
+            && SourceScan<Source>::find(Range::keyAt(offset)) != Source::size;
+    }
+
+    static constexpr std::uint64_t word(
+        std::size_t index, std::size_t bit = 0) {
+        return bit == wordBits ? 0
+            : (present(index * wordBits + bit) ? std::uint64_t{1} << bit : 0)
+                | word(index, bit + 1);
+    }
+};
+
+template <
+    typename Source,
+    typename Words = typename MakeIndexSequence<
+        KeyMaskLayout<Source>::wordCount>::Type
+>
+struct KeyMask;
+
+template <typename Source, std::size_t... Words>
+struct KeyMask<Source, IndexSequence<Words...>> {
+    using Layout = KeyMaskLayout<Source>;
+
+    static constexpr std::uint64_t words[sizeof...(Words)] = {
+        Layout::word(Words)...
+    };
+
+    /** Whether `key` is present. The layout must be usable. */
+    static constexpr bool contains(typename Source::Key key) {
+        return Layout::offsetOf(key) < Layout::span
+            && ((words[Layout::offsetOf(key) / Layout::wordBits]
+                    >> (Layout::offsetOf(key) % Layout::wordBits)) & 1) != 0;
+    }
+};
+
+template <typename Source, std::size_t... Words>
+constexpr std::uint64_t
+KeyMask<Source, IndexSequence<Words...>>::words[sizeof...(Words)];
+
+/** Rank of each present entry of a source, if keys were sorted. */
+template <
+    typename Source,
+    typename Indices = typename MakeIndexSequence<Source::size>::Type
+>
+struct SourceRanks;
+
+template <typename Source, std::size_t... Entries>
+struct SourceRanks<Source, IndexSequence<Entries...>> {
+    static constexpr std::size_t ranks[sizeof...(Entries) + 1] = {
+        SourceScan<Source>::rank(Entries)..., Source::size
+    };
+};
+
+template <typename Source, std::size_t... Entries>
+constexpr std::size_t
+SourceRanks<Source, IndexSequence<Entries...>>::ranks[
+    sizeof...(Entries) + 1];
+
+/** Layout of the tables built by the `SortedKeys` engine. */
+template <typename Source>
+struct SortedLayout {
+    using Ranks = SourceRanks<Source>;
+
+    static constexpr std::size_t count = SourceScan<Source>::count();
+
+    // Never empty.
+    static constexpr std::size_t tableSize = count == 0 ? 1 : count;
+
+    /** Entry of the source whose key is the `rank`-th smallest one. */
+    static constexpr std::size_t entry(
+        std::size_t rank,
+        std::size_t begin = 0, std::size_t end = Source::size) {
+        return end - begin == 0 ? Source::size
+            : end - begin == 1
+                ? (Ranks::ranks[begin] == rank ? begin : Source::size)
+            : firstFound(entry(rank, begin, begin + (end - begin) / 2),
+                         entry(rank, begin + (end - begin) / 2, end));
+    }
+
+    static constexpr typename Source::Key key(std::size_t rank) {
+        return rank < count ? Source::key(entry(rank)) : 0;
+    }
+
+    static constexpr typename Source::Payload payload(std::size_t rank) {
+        return rank < count ? Source::payload(entry(rank)) : 0;
+    }
+
+ private:
+    static constexpr std::size_t firstFound(std::size_t a, std::size_t b)
+    { return a != Source::size ? a : b; }
+};
+
+template <
+    typename Source,
+    typename Indices = typename MakeIndexSequence<
+        SortedLayout<Source>::tableSize>::Type
+>
+struct SortedTable;
+
+template <typename Source, std::size_t... Ranks>
+struct SortedTable<Source, IndexSequence<Ranks...>> {
+    using Layout = SortedLayout<Source>;
+    using Key = typename Source::Key;
+    using Payload = typename Source::Payload;
+
+    static constexpr Key keys[sizeof...(Ranks)] = {
+        Layout::key(Ranks)...
+    };
+
+    static constexpr Payload payloads[sizeof...(Ranks)] = {
+        Layout::payload(Ranks)...
+    };
+
+    static SEC_CONSTEXPR bool find(Key key, Payload& payload) {
+        // Each step halves the candidate range, keeping its lower bound on
+        // the last key lower than or equal to `key`. The condition compiles
+        // to a conditional move, and the loop is unrolled since the length
+        // is a constant.
+        std::size_t base = 0;
+        for (std::size_t length = Layout::count; length > 1; ) {
+            const std::size_t half = length / 2;
+            base = keys[base + half] <= key ? base + half : base;
+            length -= half;
+        }
+
+        payload = payloads[base];
+        return Layout::count != 0 && keys[base] == key;
+    }
+
+    static constexpr std::size_t tableBytes()
+    { return sizeof(keys) + sizeof(payloads); }
+};
+
+template <typename Source, std::size_t... Ranks>
+constexpr typename Source::Key
+SortedTable<Source, IndexSequence<Ranks...>>::keys[sizeof...(Ranks)];
+
+template <typename Source, std::size_t... Ranks>
+constexpr typename Source::Payload
+SortedTable<Source, IndexSequence<Ranks...>>::payloads[sizeof...(Ranks)];
+
+template <typename Source>
+using SortedTableLookup = SortedTable<Source>;
+
+/** Cell of a `ProbeTable`. */
+template <typename Payload>
+struct ProbeCell {
+    Payload payload;
+    bool present;
+};
+
+/** Layout of the table built for the lookups of raw values: one cell per
+ * key of the range, and an absent cell for the keys out of the range. It is
+ * used for tables of at most `maxBytes`.
+ */
+template <typename Source>
+struct ProbeLayout : KeyRange<Source> {
+    using Range = KeyRange<Source>;
+    using Cell = ProbeCell<typename Source::Payload>;
+
+    static constexpr std::size_t maxBytes = 4096;
+
+    static constexpr bool usable = Range::span != 0
+        && Range::span < maxBytes / sizeof(Cell);
+
+    static constexpr std::size_t tableSize = usable ? Range::span + 1 : 1;
+
+    static constexpr Cell cell(std::size_t offset) {
+        return offset < Range::span
+                && SourceScan<Source>::find(Range::keyAt(offset))
+                    != Source::size
+            ? Cell{Source::payload(SourceScan<Source>::find(
+                Range::keyAt(offset))), true}
+            : Cell{typename Source::Payload{}, false};
+    }
+};
+
+template <
+    typename Source,
+    typename Indices = typename MakeIndexSequence<
+        ProbeLayout<Source>::tableSize>::Type
+>
+struct ProbeTable;
+
+template <typename Source, std::size_t... Offsets>
+struct ProbeTable<Source, IndexSequence<Offsets...>> {
+    using Layout = ProbeLayout<Source>;
+    using Key = typename Source::Key;
+    using Payload = typename Source::Payload;
+
+    static constexpr typename Layout::Cell cells[sizeof...(Offsets)] = {
+        Layout::cell(Offsets)...
+    };
+
+    static SEC_CONSTEXPR bool find(Key key, Payload& payload) {
+        // Keys out of the range read the last cell, which is absent: the
+        // offset is clamped with a conditional move.
+        const std::size_t offset = Layout::offsetOf(key);
+        const typename Layout::Cell& cell =
+            cells[offset < Layout::span ? offset : Layout::span];
+
+        payload = cell.payload;
+        return cell.present;
+    }
+
+    static constexpr std::size_t tableBytes() { return sizeof(cells); }
+};
+
+template <typename Source, std::size_t... Offsets>
+constexpr typename ProbeLayout<Source>::Cell
+ProbeTable<Source, IndexSequence<Offsets...>>::cells[sizeof...(Offsets)];
+
+/** Lookup without branch, whatever the key: the offset when the mapping
+ * is one, a `ProbeTable` when it is small enough, and the binary search of
+ * `SortedTable`, made of conditional moves, otherwise.
+ */
+template <typename Source>
+using ProbeLookup = typename std::conditional<
+    SourceShape<Source>::affine,
+    OffsetLookup<Source>,
+typename std::conditional<
+    ProbeLayout<Source>::usable,
+    ProbeTable<Source>,
+    SortedTable<Source>
+>::type>::type;
+
+/** Implementation of a conversion direction by an engine. */
+template <typename Engine, bool toExternal, typename Converter>
+struct EngineConverter;
+
+/** Converts with a lookup built from the mapping rows. */
+template <
+    template <typename> class Lookup,
+    EngineKind kind, bool toExternal, typename Converter
+>
+struct LookupConverter {
+    using Direction = MappingDirection<toExternal, Converter>;
+    using Input = typename Direction::Input;
+    using Output = typename Direction::Output;
+    using Source = ConversionSource<Direction, Converter>;
+
+    static SEC_CONSTEXPR SEC_OPTIONAL_NS::optional<Output>
+    convertOpt(Input input) {
+        typename Source::Payload payload{};
+
+        if (!Lookup<Source>::find(toUnderlying(input), payload)) {
+            return SEC_OPTIONAL_NS::nullopt;
+        }
+
+        return static_cast<Output>(payload);
+    }
+
+    static constexpr EngineDescriptor descriptor() {
+        return EngineDescriptor{
+            kind, SourceScan<Source>::count(), Lookup<Source>::tableBytes()
+        };
+    }
+};
+
+template <bool toExternal, typename Converter>
+struct EngineConverter<engine::Switch, toExternal, Converter> {
+    using Direction = MappingDirection<toExternal, Converter>;
+    using Input = typename Direction::Input;
+    using Output = typename Direction::Output;
+
+    static SEC_CONSTEXPR SEC_OPTIONAL_NS::optional<Output>
+    convertOpt(Input input)
+    { return Direction::switchOpt(input); }
+
+    static constexpr EngineDescriptor descriptor() {
+        return EngineDescriptor{
+            EngineKind::Switch,
+            SourceScan<ConversionSource<Direction, Converter>>::count(),
+            0
+        };
+    }
+};
+
+template <bool toExternal, typename Converter>
+struct EngineConverter<engine::DenseTable, toExternal, Converter>:
+    LookupConverter<
+        DenseTableLookup, EngineKind::DenseTable, toExternal, Converter> {};
+
+template <bool toExternal, typename Converter>
+struct EngineConverter<engine::SortedKeys, toExternal, Converter>:
+    LookupConverter<
+        SortedTableLookup, EngineKind::SortedKeys, toExternal, Converter> {};
+
+template <bool toExternal, typename Converter>
+struct EngineConverter<engine::Offset, toExternal, Converter>:
+    LookupConverter<
+        OffsetLookup, EngineKind::Offset, toExternal, Converter> {};
+
+template <bool toExternal, typename Converter>
+struct EngineConverter<engine::Permutation, toExternal, Converter>:
+    LookupConverter<
+        DenseTableLookup, EngineKind::Permutation, toExternal, Converter> {
+    static_assert(
+        KeyRange<ConversionSource<
+            MappingDirection<toExternal, Converter>, Converter>>::complete,
+        "Permutation engine: the convertible values do not form a range");
+};
+
+/** Engine selected by `engine::Auto` for a source. */
+template <typename Source>
+struct AutoEngine {
+    using Range = KeyRange<Source>;
+
+    static constexpr std::size_t maxTableBytes = 1024;
+    static constexpr std::size_t minDensityDivisor = 4;
+    static constexpr std::size_t minSortedEntries = 8;
+
+    static constexpr std::size_t count = SourceScan<Source>::count();
+
+    static constexpr bool smallTable = Range::span != 0
+        && Range::span <= maxTableBytes / sizeof(typename Source::Payload);
+
+    static constexpr bool denseEnough =
+        Range::span <= count * minDensityDivisor;
+
+    using Type = typename std::conditional<
+        SourceShape<Source>::affine,
+        engine::Offset,
+    typename std::conditional<
+        Range::complete && smallTable,
+        engine::Permutation,
+    typename std::conditional<
+        smallTable && denseEnough && PayloadSentinel<Source>::available,
+        engine::DenseTable,
+    typename std::conditional<
+        count >= minSortedEntries,
+        engine::SortedKeys,
+        engine::Switch
+    >::type>::type>::type>::type;
+};
+
+template <bool toExternal, typename Converter>
+struct EngineConverter<engine::Auto, toExternal, Converter>:
+    EngineConverter<
+        typename AutoEngine<ConversionSource<
+            MappingDirection<toExternal, Converter>, Converter>>::Type,
+        toExternal,
+        Converter
+    > {};
+
+/** Whether an input has a conversion: a bit test when the inputs are
+ * close enough for a `KeyMask`, the conversion by `Engine` otherwise.
+ */
+template <typename Engine, bool toExternal, typename Converter>
+struct Convertibility {
+    using Direction = MappingDirection<toExternal, Converter>;
+    using Source = ConversionSource<Direction, Converter>;
+
+    static constexpr bool masked = KeyMaskLayout<Source>::usable;
+
+    static SEC_CONSTEXPR bool test(typename Direction::Input input) {
+        return masked ? KeyMask<Source>::contains(toUnderlying(input))
+            : EngineConverter<Engine, toExternal, Converter>::convertOpt(input)
+                .has_value();
+    }
+};
+
+}  // namespace priv
+
+template <typename Converter>
+struct EngineReport {
+    using Base = typename Converter::Converter;
+    using Engine = typename priv::Mapping<Base>::Engine;
+
+    static constexpr EngineDescriptor toInternal()
+    { return priv::EngineConverter<Engine, false, Base>::descriptor(); }
+
+    static constexpr EngineDescriptor toExternal()
+    { return priv::EngineConverter<Engine, true, Base>::descriptor(); }
+};
+
+}  // namespace lguim
+
+#endif  // LGUIM_SECUREENUMCONVERTER_ENGINES_H_
@@ -0,0 +1,146 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_SECUREENUMCONVERTER_PATHS_H_
+#define LGUIM_SECUREENUMCONVERTER_PATHS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+#include "lguim/secureenumconverter.h"
+#include "lguim/secureenumconverter_simd.h"
+
+namespace lguim {
+
+namespace priv {
+
+/** Members of a converter for one conversion direction which read the
+ * mapping rows when `rows` is true, and otherwise go through `Engine` and
+ * the sets of values. Selected by `secureenumconverter.inc`, so that
+ * converters without rows never instantiate the code reading them.
+ */
+template <bool rows, typename Engine, bool toExternal, typename Converter>
+struct MappingPaths;
+
+template <typename Engine, bool toExternal, typename Converter>
+struct MappingPaths<true, Engine, toExternal, Converter> {
+    using Input = typename MappingDirection<toExternal, Converter>::Input;
+    using Output = typename MappingDirection<toExternal, Converter>::Output;
+    using HalfEngine = EngineConverter<Engine, toExternal, Converter>;
+
+    static SEC_CONSTEXPR bool isConvertible(Input input)
+    { return Convertibility<Engine, toExternal, Converter>::test(input); }
+
+    static std::size_t firstInvalid(const Input* values, std::size_t count) {
+        return SimdValidation<Engine, toExternal, Converter>::firstInvalid(
+            values, count);
+    }
+
+    // Vector kernels are used when the mapping fits one.
+    static BatchResult convertBatch(
+        const Input* input, std::size_t count, Output* output) {
+        return SimdBatch<HalfEngine, toExternal, Converter>::convert(
+            input, count, output);
+    }
+
+    static SEC_CONSTEXPR ValueSpan<Input> convertibleSpan()
+    { return SortedInputs<toExternal, Converter>::span(); }
+
+    // To internal only: the lookups of `fromUnderlying`.
+    static bool findUnderlying(
+        UnderlyingType<Input> raw, typename Converter::Internal& internal)
+    { return UnderlyingLookup<Converter>::find(raw, internal); }
+
+    // The underlying values are converted as external values by the vector
+    // kernels, then by the branchless lookup.
+    static BatchResult fromUnderlyingBatch(
+        const UnderlyingType<Input>* raw, std::size_t count, Output* output,
+        std::uint8_t* validity) {
+        KernelResult result{{0, count}, validity};
+        const std::size_t done =
+            SimdBatch<HalfEngine, toExternal, Converter>::convertBlocks(
+                detectIsa(), reinterpret_cast<const Input*>(raw), count,
+                output, result);
+
+        const BatchResult rest = findBatch<UnderlyingLookup<Converter>>(
+            raw + done, count - done, output + done,
+            validity != nullptr ? validity + done / 8 : nullptr);
+
+        if (rest.invalidCount != 0 && result.batch.invalidCount == 0) {
+            result.batch.firstInvalid = done + rest.firstInvalid;
+        }
+        result.batch.invalidCount += rest.invalidCount;
+        return result.batch;
+    }
+};
+
+/** Convertible values of the inputs of one conversion direction. */
+template <typename Converter>
+inline const std::set<typename Converter::Internal>& convertibleInputs(
+    std::true_type /* toExternal */)
+{ return Converter::convertibleInternalValues(); }
+
+template <typename Converter>
+inline const std::set<typename Converter::External>& convertibleInputs(
+    std::false_type /* toExternal */)
+{ return Converter::convertibleExternalValues(); }
+
+/** Same, as a sorted array copied once from the set: the types may not be
+ * literal types.
+ */
+template <bool toExternal, typename Converter>
+inline ValueSpan<typename MappingDirection<toExternal, Converter>::Input>
+copiedSpan() {
+    using Input = typename MappingDirection<toExternal, Converter>::Input;
+
+    static const std::vector<Input> values(
+        convertibleInputs<Converter>(
+            std::integral_constant<bool, toExternal>()).begin(),
+        convertibleInputs<Converter>(
+            std::integral_constant<bool, toExternal>()).end());
+
+    return ValueSpan<Input>(values.data(), values.size());
+}
+
+template <typename Engine, bool toExternal, typename Converter>
+struct MappingPaths<false, Engine, toExternal, Converter> {
+    using Input = typename MappingDirection<toExternal, Converter>::Input;
+    using Output = typename MappingDirection<toExternal, Converter>::Output;
+    using HalfEngine = EngineConverter<Engine, toExternal, Converter>;
+
+    static SEC_CONSTEXPR bool isConvertible(Input input)
+    { return HalfEngine::convertOpt(input).has_value(); }
+
+    static std::size_t firstInvalid(const Input* values, std::size_t count)
+    { return priv::firstInvalid<HalfEngine>(values, count); }
+
+    static BatchResult convertBatch(
+        const Input* input, std::size_t count, Output* output)
+    { return priv::convertBatch<HalfEngine>(input, count, output); }
+
+    // Declared constexpr so that the members of the converter can be, but
+    // never a constant expression.
+    static SEC_CONSTEXPR ValueSpan<Input> convertibleSpan()
+    { return copiedSpan<toExternal, Converter>(); }
+
+    // To internal only: the lookups of `fromUnderlying`.
+    static bool findUnderlying(
+        UnderlyingType<Input> raw, typename Converter::Internal& internal)
+    { return UnderlyingConversion<Converter>::find(raw, internal); }
+
+    static BatchResult fromUnderlyingBatch(
+        const UnderlyingType<Input>* raw, std::size_t count, Output* output,
+        std::uint8_t* validity) {
+        return findBatch<UnderlyingConversion<Converter>>(
+            raw, count, output, validity);
+    }
+};
+
+}  // namespace priv
+
+}  // namespace lguim
+
+#endif  // LGUIM_SECUREENUMCONVERTER_PATHS_H_
@@ -0,0 +1,916 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_SECUREENUMCONVERTER_SIMD_H_
+#define LGUIM_SECUREENUMCONVERTER_SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "lguim/secureenumconverter.h"
+
+// Vector kernels are compiled for x86-64 with GCC-compatible compilers,
+// each with its own target attribute, and selected at runtime. Defining
+// `SEC_NO_SIMD` keeps only the scalar code.
+#if !defined(SEC_NO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+    #define LGUIM_SEC_SIMD_X86 1
+    #include <immintrin.h>
+#else
+    #define LGUIM_SEC_SIMD_X86 0
+#endif
+
+namespace lguim {
+
+namespace priv {
+
+/** Instruction sets of the batch kernels, from the least capable. */
+enum class Isa { Scalar, Sse42, Avx2, Avx512Vbmi };
+
+/** Best instruction set supported by the running CPU. */
+inline Isa detectIsa() {
+#if LGUIM_SEC_SIMD_X86
+    if (__builtin_cpu_supports("avx512bw")
+        && __builtin_cpu_supports("avx512vbmi")) {
+        return Isa::Avx512Vbmi;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return Isa::Avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return Isa::Sse42;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+/** Result of the kernels: the batch result and, when `validity` is not
+ * null, the bits of the converted values, in the layout of
+ * `SecureEnumConverter::toInternalColumn`.
+ */
+struct KernelResult {
+    BatchResult batch;
+    std::uint8_t* validity;
+};
+
+/** Adds a block of `lanes` values starting at `base`, both multiples of 8,
+ * whose invalid values are the set bits of `invalid` (bit `i` for the value
+ * `base + i`), to `result`.
+ */
+inline void addInvalid(
+    KernelResult& result, std::uint64_t invalid, std::size_t base,
+    std::size_t lanes) {
+    if (invalid != 0) {
+        if (result.batch.invalidCount == 0) {
+            result.batch.firstInvalid =
+                base + static_cast<std::size_t>(__builtin_ctzll(invalid));
+        }
+        result.batch.invalidCount +=
+            static_cast<std::size_t>(__builtin_popcountll(invalid));
+    }
+
+    if (result.validity != nullptr) {
+        for (std::size_t byte = 0; byte < lanes / 8; ++byte) {
+            result.validity[base / 8 + byte] =
+                static_cast<std::uint8_t>(~invalid >> (8 * byte));
+        }
+    }
+}
+
+/** Cells of the byte tables: the conversion of `first + offset`. */
+template <typename Source>
+struct ByteCells {
+    using Range = KeyRange<Source>;
+
+    static constexpr std::size_t entry(std::size_t offset) {
+        return offset < Range::span
+            ? SourceScan<Source>::find(Range::keyAt(offset)) : Source::size;
+    }
+
+    static constexpr std::uint8_t payload(std::size_t offset) {
+        return entry(offset) == Source::size ? 0
+            : static_cast<std::uint8_t>(Source::payload(entry(offset)));
+    }
+
+    static constexpr std::uint8_t valid(std::size_t offset)
+    { return entry(offset) == Source::size ? 0 : 0xFF; }
+};
+
+/** Tables of the byte kernels: 64 payloads and validity bytes, indexed by
+ * the offset of the input from the lowest one.
+ */
+template <
+    typename Source,
+    typename Offsets = typename MakeIndexSequence<64>::Type
+>
+struct ByteTables;
+
+template <typename Source, std::size_t... Offsets>
+struct ByteTables<Source, IndexSequence<Offsets...>> {
+    static constexpr std::uint8_t payloads[64] = {
+        ByteCells<Source>::payload(Offsets)...
+    };
+
+    static constexpr std::uint8_t valid[64] = {
+        ByteCells<Source>::valid(Offsets)...
+    };
+};
+
+template <typename Source, std::size_t... Offsets>
+constexpr std::uint8_t
+ByteTables<Source, IndexSequence<Offsets...>>::payloads[64];
+
+template <typename Source, std::size_t... Offsets>
+constexpr std::uint8_t
+ByteTables<Source, IndexSequence<Offsets...>>::valid[64];
+
+/** Tables of the gather kernel, one 32-bit cell per offset. For 8 or
+ * 16-bit payloads, `cells` holds the payload in the low 16 bits and a
+ * validity flag in bit 16. For 32-bit payloads, `cells` holds the payload
+ * and `valid` the validity, all bits set or clear.
+ */
+template <
+    typename Source,
+    typename Offsets = typename MakeIndexSequence<
+        KeyRange<Source>::span == 0 ? 1 : KeyRange<Source>::span>::Type
+>
+struct GatherTable;
+
+template <typename Source, std::size_t... Offsets>
+struct GatherTable<Source, IndexSequence<Offsets...>> {
+    using UnsignedPayload =
+        typename std::make_unsigned<typename Source::Payload>::type;
+
+    static constexpr bool wide = sizeof(UnsignedPayload) == 4;
+
+    static constexpr std::int32_t validFlag = 0x10000;
+
+    static constexpr std::int32_t cell(std::size_t entry) {
+        return entry == Source::size ? 0
+            : static_cast<std::int32_t>(
+                (wide ? 0 : validFlag)
+                    | static_cast<std::uint32_t>(
+                        static_cast<UnsignedPayload>(Source::payload(entry))));
+    }
+
+    static constexpr std::int32_t validCell(std::size_t entry)
+    { return entry == Source::size ? 0 : -1; }
+
+    static constexpr std::int32_t cells[sizeof...(Offsets)] = {
+        cell(ByteCells<Source>::entry(Offsets))...
+    };
+
+    static constexpr std::int32_t valid[sizeof...(Offsets)] = {
+        validCell(ByteCells<Source>::entry(Offsets))...
+    };
+};
+
+template <typename Source, std::size_t... Offsets>
+constexpr std::int32_t
+GatherTable<Source, IndexSequence<Offsets...>>::cells[sizeof...(Offsets)];
+
+template <typename Source, std::size_t... Offsets>
+constexpr std::int32_t
+GatherTable<Source, IndexSequence<Offsets...>>::valid[sizeof...(Offsets)];
+
+/** Kernels for 8-bit inputs and outputs, whose inputs span at most 64
+ * values: the conversion is a byte shuffle, 16, 32 or 64 values at once.
+ */
+template <typename Source>
+struct ByteKernels {
+    using Range = KeyRange<Source>;
+    using Tables = ByteTables<Source>;
+
+    static constexpr bool usable = sizeof(typename Source::Key) == 1
+        && sizeof(typename Source::Payload) == 1
+        && Range::span != 0 && Range::span <= 64;
+
+    static constexpr std::size_t span = Range::span;
+
+    static bool supports(Isa isa) {
+        return (isa == Isa::Avx512Vbmi && span <= 64)
+            || (isa == Isa::Avx2 && span <= 32)
+            || (isa == Isa::Sse42 && span <= 16);
+    }
+
+#if LGUIM_SEC_SIMD_X86
+    /** Converts whole blocks, returning the number of converted values. */
+    static std::size_t run(
+        Isa isa, const unsigned char* input, std::size_t count,
+        unsigned char* output, KernelResult& result) {
+        switch (isa) {
+            case Isa::Avx512Vbmi: return avx512(input, count, output, result);
+            case Isa::Avx2: return avx2(input, count, output, result);
+            case Isa::Sse42: return sse42(input, count, output, result);
+            case Isa::Scalar: return 0;
+        }
+        return 0;
+    }
+
+    __attribute__((target("avx512f,avx512bw,avx512vbmi")))
+    static std::size_t avx512(
+        const unsigned char* input, std::size_t count,
+        unsigned char* output, KernelResult& result) {
+        const __m512i first = _mm512_set1_epi8(static_cast<char>(Range::first));
+        const __m512i limit = _mm512_set1_epi8(static_cast<char>(span));
+        const __m512i payloads = _mm512_loadu_si512(Tables::payloads);
+        const __m512i valid = _mm512_loadu_si512(Tables::valid);
+
+        std::size_t i = 0;
+        for (; i + 64 <= count; i += 64) {
+            const __m512i offsets =
+                _mm512_sub_epi8(_mm512_loadu_si512(input + i), first);
+            const __mmask64 inRange = _mm512_cmplt_epu8_mask(offsets, limit);
+            const __m512i validity = _mm512_permutexvar_epi8(offsets, valid);
+            const __mmask64 converted =
+                _mm512_mask_test_epi8_mask(inRange, validity, validity);
+
+            _mm512_mask_storeu_epi8(
+                output + i, converted,
+                _mm512_permutexvar_epi8(offsets, payloads));
+            addInvalid(
+                result, ~static_cast<std::uint64_t>(converted), i, 64);
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2")))
+    static std::size_t avx2(
+        const unsigned char* input, std::size_t count,
+        unsigned char* output, KernelResult& result) {
+        // `vpshufb` looks up 16-byte tables: the low and high halves of
+        // the range are looked up separately, and selected with bit 4.
+        const __m256i first = _mm256_set1_epi8(static_cast<char>(Range::first));
+        const __m256i last = _mm256_set1_epi8(static_cast<char>(span - 1));
+        const __m256i bit4 = _mm256_set1_epi8(0x10);
+        const __m256i payloadsLow = broadcast(Tables::payloads);
+        const __m256i payloadsHigh = broadcast(Tables::payloads + 16);
+        const __m256i validLow = broadcast(Tables::valid);
+        const __m256i validHigh = broadcast(Tables::valid + 16);
+
+        std::size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            const __m256i offsets = _mm256_sub_epi8(
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(input + i)),
+                first);
+            const __m256i inRange = _mm256_cmpeq_epi8(
+                _mm256_min_epu8(offsets, last), offsets);
+            const __m256i high = _mm256_cmpeq_epi8(
+                _mm256_and_si256(offsets, bit4), bit4);
+
+            const __m256i values = _mm256_blendv_epi8(
+                _mm256_shuffle_epi8(payloadsLow, offsets),
+                _mm256_shuffle_epi8(payloadsHigh, offsets), high);
+            const __m256i converted = _mm256_and_si256(inRange,
+                _mm256_blendv_epi8(
+                    _mm256_shuffle_epi8(validLow, offsets),
+                    _mm256_shuffle_epi8(validHigh, offsets), high));
+
+            __m256i* out = reinterpret_cast<__m256i*>(output + i);
+            _mm256_storeu_si256(out, _mm256_blendv_epi8(
+                _mm256_loadu_si256(out), values, converted));
+
+            const std::uint32_t mask =
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(converted));
+            addInvalid(result, ~mask, i, 32);
+        }
+        return i;
+    }
+
+    __attribute__((target("sse4.2")))
+    static std::size_t sse42(
+        const unsigned char* input, std::size_t count,
+        unsigned char* output, KernelResult& result) {
+        const __m128i first = _mm_set1_epi8(static_cast<char>(Range::first));
+        const __m128i last = _mm_set1_epi8(static_cast<char>(span - 1));
+        const __m128i payloads = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(Tables::payloads));
+        const __m128i valid = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(Tables::valid));
+
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m128i offsets = _mm_sub_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)),
+                first);
+            const __m128i inRange =
+                _mm_cmpeq_epi8(_mm_min_epu8(offsets, last), offsets);
+            const __m128i converted =
+                _mm_and_si128(inRange, _mm_shuffle_epi8(valid, offsets));
+
+            __m128i* out = reinterpret_cast<__m128i*>(output + i);
+            _mm_storeu_si128(out, _mm_blendv_epi8(
+                _mm_loadu_si128(out), _mm_shuffle_epi8(payloads, offsets),
+                converted));
+
+            const std::uint32_t mask =
+                static_cast<std::uint32_t>(_mm_movemask_epi8(converted));
+            addInvalid(result, ~mask & 0xFFFFu, i, 16);
+        }
+        return i;
+    }
+
+ private:
+    __attribute__((target("avx2")))
+    static __m256i broadcast(const std::uint8_t* table) {
+        return _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+    }
+#endif  // LGUIM_SEC_SIMD_X86
+};
+
+#if LGUIM_SEC_SIMD_X86
+/** Loads 8 16 or 32-bit keys, extended to 32 bits. */
+template <typename Key>
+__attribute__((target("avx2")))
+inline __m256i loadKeys(const unsigned char* input) {
+    return sizeof(Key) == 4
+        ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input))
+        : std::is_signed<Key>::value
+            ? _mm256_cvtepi16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(input)))
+            : _mm256_cvtepu16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(input)));
+}
+#endif  // LGUIM_SEC_SIMD_X86
+
+/** Kernel for 16 or 32-bit inputs spanning at most 1024 values, with 8,
+ * 16 or 32-bit outputs: the conversion is a gather from a table of 32-bit
+ * cells, 8 values at once. 32-bit outputs gather their validity from a
+ * second table, and are stored with a masked store.
+ */
+template <typename Source>
+struct GatherKernels {
+    using Key = typename Source::Key;
+    using Payload = typename Source::Payload;
+    using Range = KeyRange<Source>;
+
+    static constexpr std::size_t maxSpan = 1024;
+
+    static constexpr bool usable =
+        (sizeof(Key) == 2 || sizeof(Key) == 4) && sizeof(Payload) <= 4
+        && Range::span != 0 && Range::span <= maxSpan;
+
+    static bool supports(Isa isa)
+    { return isa == Isa::Avx2 || isa == Isa::Avx512Vbmi; }
+
+#if LGUIM_SEC_SIMD_X86
+    template <typename Output>
+    static std::size_t run(
+        Isa isa, const unsigned char* input, std::size_t count,
+        Output* output, KernelResult& result) {
+        return isa == Isa::Scalar || isa == Isa::Sse42
+            ? 0 : avx2(input, count, output, result);
+    }
+
+    template <typename Output>
+    __attribute__((target("avx2")))
+    static std::size_t avx2(
+        const unsigned char* input, std::size_t count,
+        Output* output, KernelResult& result) {
+        const __m256i first =
+            _mm256_set1_epi32(static_cast<std::int32_t>(Range::first));
+        const __m256i last =
+            _mm256_set1_epi32(static_cast<std::int32_t>(Range::span - 1));
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256i offsets =
+                _mm256_sub_epi32(loadKeys<Key>(input + i * sizeof(Key)), first);
+            const __m256i inRange = _mm256_cmpeq_epi32(
+                _mm256_min_epu32(offsets, last), offsets);
+
+            const std::uint32_t mask = block(
+                offsets, inRange, output + i,
+                std::integral_constant<bool, Table::wide>());
+            addInvalid(result, ~mask & 0xFFu, i, 8);
+        }
+        return i;
+    }
+
+ private:
+    /** Source of a table of one cell, for the unusable cases. */
+    struct DummySource {
+        using Key = std::int32_t;
+        using Payload = std::int16_t;
+        static constexpr std::size_t size = 0;
+        static constexpr bool has(std::size_t) { return false; }
+        static constexpr Key key(std::size_t) { return 0; }
+        static constexpr Payload payload(std::size_t) { return 0; }
+    };
+
+    using Table = GatherTable<typename std::conditional<
+        usable, Source, DummySource>::type>;
+
+    /** Converts 8 values of `offsets`, returning the mask of the
+     * converted ones.
+     */
+    template <typename Output>
+    __attribute__((target("avx2"), always_inline))
+    static std::uint32_t block(
+        __m256i offsets, __m256i inRange, Output* output,
+        std::false_type /* wide */) {
+        const __m256i flag = _mm256_set1_epi32(Table::validFlag);
+        alignas(32) std::int32_t cells[8];
+
+        const __m256i gathered = _mm256_mask_i32gather_epi32(
+            _mm256_setzero_si256(), Table::cells, offsets, inRange, 4);
+        const __m256i converted = _mm256_cmpeq_epi32(
+            _mm256_and_si256(gathered, flag), flag);
+
+        const std::uint32_t mask = static_cast<std::uint32_t>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(converted)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(cells), gathered);
+
+        for (std::size_t lane = 0; lane < 8; ++lane) {
+            if (mask & (1u << lane)) {
+                output[lane] = static_cast<Output>(
+                    static_cast<Payload>(cells[lane]));
+            }
+        }
+        return mask;
+    }
+
+    template <typename Output>
+    __attribute__((target("avx2"), always_inline))
+    static std::uint32_t block(
+        __m256i offsets, __m256i inRange, Output* output,
+        std::true_type /* wide */) {
+        const __m256i converted = _mm256_mask_i32gather_epi32(
+            _mm256_setzero_si256(), Table::valid, offsets, inRange, 4);
+        const __m256i gathered = _mm256_mask_i32gather_epi32(
+            _mm256_setzero_si256(), Table::cells, offsets, converted, 4);
+
+        _mm256_maskstore_epi32(
+            reinterpret_cast<int*>(output), converted, gathered);
+        return static_cast<std::uint32_t>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(converted)));
+    }
+#endif  // LGUIM_SEC_SIMD_X86
+};
+
+/** Vector of `bytes` bytes of `Lane`, with the GCC vector extensions: the
+ * same code is compiled for each instruction set by the target attribute
+ * of the kernel it is inlined in.
+ */
+template <typename Lane, std::size_t bytes>
+struct LaneVector {
+    typedef Lane Type __attribute__((vector_size(bytes)));
+};
+
+/** Kernels for mappings which add a constant to the inputs (`engine::Offset`
+ * mappings), with inputs and outputs of 8, 16 or 32 bits: a range check and
+ * a vector add. For identity mappings, blocks whose inputs are all in the
+ * range are copied as they are.
+ */
+template <typename Source>
+struct AffineKernels {
+    using Key = typename Source::Key;
+    using Lane = typename std::make_unsigned<Key>::type;
+    using Range = KeyRange<Source>;
+    using Shape = SourceShape<Source>;
+
+    static constexpr bool usable = Shape::affine
+        && sizeof(Key) == sizeof(typename Source::Payload)
+        && sizeof(Key) <= 4;
+
+    static constexpr Lane offset = static_cast<Lane>(Shape::offset);
+
+    static constexpr bool identity = offset == 0;
+
+    static bool supports(Isa isa) { return isa != Isa::Scalar; }
+
+#if LGUIM_SEC_SIMD_X86
+    static std::size_t run(
+        Isa isa, const unsigned char* input, std::size_t count,
+        unsigned char* output, KernelResult& result) {
+        switch (isa) {
+            case Isa::Avx512Vbmi:
+            case Isa::Avx2: return avx2(input, count, output, result);
+            case Isa::Sse42: return sse42(input, count, output, result);
+            case Isa::Scalar: return 0;
+        }
+        return 0;
+    }
+
+    __attribute__((target("avx2")))
+    static std::size_t avx2(
+        const unsigned char* input, std::size_t count,
+        unsigned char* output, KernelResult& result)
+    { return blocks<32>(input, count, output, result); }
+
+    __attribute__((target("sse4.2")))
+    static std::size_t sse42(
+        const unsigned char* input, std::size_t count,
+        unsigned char* output, KernelResult& result)
+    { return blocks<16>(input, count, output, result); }
+
+ private:
+    /** Converts blocks of at least 8 values, one vector of `bytes` bytes
+     * or, for 32-bit lanes in 16 bytes, two of them: the validity bits of
+     * each block fill whole bytes.
+     */
+    template <std::size_t bytes>
+    __attribute__((always_inline))
+    static std::size_t blocks(
+        const unsigned char* input, std::size_t count,
+        unsigned char* output, KernelResult& result) {
+        using Vector = typename LaneVector<Lane, bytes>::Type;
+        constexpr std::size_t lanes = bytes / sizeof(Lane);
+        constexpr std::size_t vectors = lanes < 8 ? 8 / lanes : 1;
+
+        const Lane first = static_cast<Lane>(Range::first);
+        const Lane last = static_cast<Lane>(Range::span - 1);
+
+        std::size_t i = 0;
+        for (; i + vectors * lanes <= count; i += vectors * lanes) {
+            std::uint64_t invalid = 0;
+            for (std::size_t vector = 0; vector < vectors; ++vector) {
+                const std::size_t at = i + vector * lanes;
+
+                Vector keys;
+                std::memcpy(&keys, input + at * sizeof(Lane), bytes);
+
+                // Lanes of all ones for the inputs of the range
+                const Vector inRange = keys - first <= last;
+                const Vector converted = identity ? keys : keys + offset;
+
+                if (allSet<bytes>(inRange)) {
+                    std::memcpy(output + at * sizeof(Lane), &converted, bytes);
+                    continue;
+                }
+
+                Vector previous;
+                std::memcpy(&previous, output + at * sizeof(Lane), bytes);
+                const Vector kept = inRange ? converted : previous;
+                std::memcpy(output + at * sizeof(Lane), &kept, bytes);
+
+                for (std::size_t lane = 0; lane < lanes; ++lane) {
+                    invalid |= std::uint64_t{inRange[lane] == 0}
+                        << (vector * lanes + lane);
+                }
+            }
+            addInvalid(result, invalid, i, vectors * lanes);
+        }
+        return i;
+    }
+
+    template <std::size_t bytes, typename Vector>
+    __attribute__((always_inline))
+    static bool allSet(const Vector& lanes) {
+        typename LaneVector<std::uint64_t, bytes>::Type words;
+        std::memcpy(&words, &lanes, bytes);
+
+        std::uint64_t all = words[0];
+        for (std::size_t word = 1; word < bytes / 8; ++word) {
+            all &= words[word];
+        }
+        return all == ~std::uint64_t{0};
+    }
+#endif  // LGUIM_SEC_SIMD_X86
+};
+
+/** Batch conversion with the vector kernels when the mapping allows one,
+ * and `Engine` for the other mappings and the last values.
+ */
+template <typename Engine, bool toExternal, typename Converter>
+struct SimdBatch {
+    using Input = typename Engine::Input;
+    using Output = typename Engine::Output;
+    using Source = ConversionSource<
+        MappingDirection<toExternal, Converter>, Converter>;
+
+    using Affine = AffineKernels<Source>;
+    using Bytes = ByteKernels<Source>;
+    using Gather = GatherKernels<Source>;
+
+    /** Whether a kernel exists for `isa`. The affine kernels are preferred
+     * to the tables.
+     */
+    static bool supports(Isa isa) {
+        return Affine::usable ? Affine::supports(isa)
+            : (Bytes::usable && Bytes::supports(isa))
+                || (Gather::usable && Gather::supports(isa));
+    }
+
+    static BatchResult convert(
+        const Input* input, std::size_t count, Output* output) {
+        static_assert(
+            sizeof(Input) == sizeof(typename Source::Key)
+                && sizeof(Output) == sizeof(typename Source::Payload),
+            "Enumerations are stored as their underlying type");
+        return convertWith(detectIsa(), input, count, output);
+    }
+
+    /** Conversion with the kernel for `isa`, or the scalar code if there
+     * is none. Exposed for the tests.
+     */
+    static BatchResult convertWith(
+        Isa isa, const Input* input, std::size_t count, Output* output) {
+        KernelResult result{{0, count}, nullptr};
+        const std::size_t done = convertBlocks(
+            isa, input, count, output, result);
+
+        const BatchResult rest =
+            convertBatch<Engine>(input + done, count - done, output + done);
+
+        if (rest.invalidCount != 0 && result.batch.invalidCount == 0) {
+            result.batch.firstInvalid = done + rest.firstInvalid;
+        }
+        result.batch.invalidCount += rest.invalidCount;
+        return result.batch;
+    }
+
+    /** Converts the whole blocks of the kernel for `isa`, returning the
+     * number of converted values, a multiple of 8: zero if there is no
+     * kernel. The last values are left to the caller.
+     */
+    static std::size_t convertBlocks(
+        Isa isa, const Input* input, std::size_t count, Output* output,
+        KernelResult& result) {
+        return supports(isa)
+            ? run(isa, input, count, output, result,
+                  std::integral_constant<bool, Affine::usable>())
+            : 0;
+    }
+
+ private:
+    static std::size_t run(
+        Isa isa, const Input* input, std::size_t count, Output* output,
+        KernelResult& result, std::true_type /* affine */) {
+#if LGUIM_SEC_SIMD_X86
+        return Affine::run(
+            isa, reinterpret_cast<const unsigned char*>(input), count,
+            reinterpret_cast<unsigned char*>(output), result);
+#else
+        return 0;
+#endif
+    }
+
+    static std::size_t run(
+        Isa isa, const Input* input, std::size_t count, Output* output,
+        KernelResult& result, std::false_type /* affine */) {
+        return runTable(
+            isa, input, count, output, result,
+            std::integral_constant<bool, Bytes::usable>());
+    }
+
+    static std::size_t runTable(
+        Isa isa, const Input* input, std::size_t count, Output* output,
+        KernelResult& result, std::true_type /* bytes */) {
+#if LGUIM_SEC_SIMD_X86
+        return Bytes::run(
+            isa, reinterpret_cast<const unsigned char*>(input), count,
+            reinterpret_cast<unsigned char*>(output), result);
+#else
+        return 0;
+#endif
+    }
+
+    static std::size_t runTable(
+        Isa isa, const Input* input, std::size_t count, Output* output,
+        KernelResult& result, std::false_type /* bytes */) {
+#if LGUIM_SEC_SIMD_X86
+        return Gather::usable
+            ? Gather::run(
+                isa, reinterpret_cast<const unsigned char*>(input), count,
+                output, result)
+            : 0;
+#else
+        return 0;
+#endif
+    }
+};
+
+/** Kernels looking for the first input without conversion: the validity
+ * part of the byte kernels for 8-bit inputs spanning at most 64 values,
+ * and a gather from the `KeyMask` words for 16 and 32-bit inputs.
+ */
+template <typename Source>
+struct ValidationKernels {
+    using Key = typename Source::Key;
+    using Range = KeyRange<Source>;
+    using Layout = KeyMaskLayout<Source>;
+
+    static constexpr bool bytes = sizeof(Key) == 1
+        && Range::span != 0 && Range::span <= 64;
+
+    static constexpr bool gather =
+        (sizeof(Key) == 2 || sizeof(Key) == 4) && Layout::usable;
+
+    static bool supports(Isa isa) {
+        return bytes
+            ? (isa == Isa::Avx512Vbmi && Range::span <= 64)
+                || (isa == Isa::Avx2 && Range::span <= 32)
+                || (isa == Isa::Sse42 && Range::span <= 16)
+            : gather && (isa == Isa::Avx2 || isa == Isa::Avx512Vbmi);
+    }
+
+#if LGUIM_SEC_SIMD_X86
+    /** Index of the first invalid input if one is found in the whole
+     * blocks, or the number of values of the whole blocks.
+     */
+    static std::size_t run(
+        Isa isa, const unsigned char* input, std::size_t count, bool& found) {
+        found = false;
+        switch (isa) {
+            case Isa::Avx512Vbmi:
+                return bytes ? avx512(input, count, found)
+                    : gatherAvx2(input, count, found);
+            case Isa::Avx2:
+                return bytes ? avx2(input, count, found)
+                    : gatherAvx2(input, count, found);
+            case Isa::Sse42: return sse42(input, count, found);
+            case Isa::Scalar: return 0;
+        }
+        return 0;
+    }
+
+ private:
+    using Tables = ByteTables<Source>;
+
+    static std::size_t firstClear(
+        std::size_t base, std::uint64_t valid, bool& found) {
+        found = true;
+        return base + static_cast<std::size_t>(__builtin_ctzll(~valid));
+    }
+
+    __attribute__((target("avx512f,avx512bw,avx512vbmi")))
+    static std::size_t avx512(
+        const unsigned char* input, std::size_t count, bool& found) {
+        const __m512i first = _mm512_set1_epi8(static_cast<char>(Range::first));
+        const __m512i limit =
+            _mm512_set1_epi8(static_cast<char>(Range::span));
+        const __m512i valid = _mm512_loadu_si512(Tables::valid);
+
+        std::size_t i = 0;
+        for (; i + 64 <= count; i += 64) {
+            const __m512i offsets =
+                _mm512_sub_epi8(_mm512_loadu_si512(input + i), first);
+            const __mmask64 inRange = _mm512_cmplt_epu8_mask(offsets, limit);
+            const __m512i validity = _mm512_permutexvar_epi8(offsets, valid);
+            const std::uint64_t converted = static_cast<std::uint64_t>(
+                _mm512_mask_test_epi8_mask(inRange, validity, validity));
+
+            if (converted != ~std::uint64_t{0}) {
+                return firstClear(i, converted, found);
+            }
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2")))
+    static std::size_t avx2(
+        const unsigned char* input, std::size_t count, bool& found) {
+        const __m256i first = _mm256_set1_epi8(static_cast<char>(Range::first));
+        const __m256i last =
+            _mm256_set1_epi8(static_cast<char>(Range::span - 1));
+        const __m256i bit4 = _mm256_set1_epi8(0x10);
+        const __m256i validLow = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(Tables::valid)));
+        const __m256i validHigh = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(Tables::valid + 16)));
+
+        std::size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            const __m256i offsets = _mm256_sub_epi8(
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(input + i)),
+                first);
+            const __m256i inRange = _mm256_cmpeq_epi8(
+                _mm256_min_epu8(offsets, last), offsets);
+            const __m256i high = _mm256_cmpeq_epi8(
+                _mm256_and_si256(offsets, bit4), bit4);
+            const __m256i converted = _mm256_and_si256(inRange,
+                _mm256_blendv_epi8(
+                    _mm256_shuffle_epi8(validLow, offsets),
+                    _mm256_shuffle_epi8(validHigh, offsets), high));
+
+            const std::uint32_t mask =
+                static_cast<std::uint32_t>(_mm256_movemask_epi8(converted));
+            if (mask != 0xFFFFFFFFu) {
+                return firstClear(i, mask, found);
+            }
+        }
+        return i;
+    }
+
+    __attribute__((target("sse4.2")))
+    static std::size_t sse42(
+        const unsigned char* input, std::size_t count, bool& found) {
+        const __m128i first = _mm_set1_epi8(static_cast<char>(Range::first));
+        const __m128i last = _mm_set1_epi8(static_cast<char>(Range::span - 1));
+        const __m128i valid = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(Tables::valid));
+
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            const __m128i offsets = _mm_sub_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)),
+                first);
+            const __m128i inRange =
+                _mm_cmpeq_epi8(_mm_min_epu8(offsets, last), offsets);
+            const __m128i converted =
+                _mm_and_si128(inRange, _mm_shuffle_epi8(valid, offsets));
+
+            const std::uint32_t mask =
+                static_cast<std::uint32_t>(_mm_movemask_epi8(converted));
+            if (mask != 0xFFFFu) {
+                return firstClear(i, mask, found);
+            }
+        }
+        return i;
+    }
+
+    /** The mask words are read as 32-bit words: bit `offset % 32` of word
+     * `offset / 32` on little-endian targets.
+     */
+    __attribute__((target("avx2")))
+    static std::size_t gatherAvx2(
+        const unsigned char* input, std::size_t count, bool& found) {
+        const int* words = reinterpret_cast<const int*>(KeyMask<Source>::words);
+        const __m256i first =
+            _mm256_set1_epi32(static_cast<std::int32_t>(Range::first));
+        const __m256i last =
+            _mm256_set1_epi32(static_cast<std::int32_t>(Range::span - 1));
+        const __m256i low5 = _mm256_set1_epi32(31);
+        const __m256i one = _mm256_set1_epi32(1);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            const __m256i offsets =
+                _mm256_sub_epi32(loadKeys<Key>(input + i * sizeof(Key)), first);
+            const __m256i inRange = _mm256_cmpeq_epi32(
+                _mm256_min_epu32(offsets, last), offsets);
+            const __m256i gathered = _mm256_mask_i32gather_epi32(
+                _mm256_setzero_si256(), words,
+                _mm256_srli_epi32(offsets, 5), inRange, 4);
+            const __m256i bits = _mm256_and_si256(
+                _mm256_srlv_epi32(gathered, _mm256_and_si256(offsets, low5)),
+                one);
+
+            const std::uint32_t mask = static_cast<std::uint32_t>(
+                _mm256_movemask_ps(_mm256_castsi256_ps(
+                    _mm256_cmpeq_epi32(bits, one))));
+            if (mask != 0xFFu) {
+                return firstClear(i, mask | ~std::uint32_t{0xFF}, found);
+            }
+        }
+        return i;
+    }
+#endif  // LGUIM_SEC_SIMD_X86
+};
+
+/** Search of the first input without conversion with the vector kernels
+ * when the mapping allows one, and `Convertibility` for the other mappings
+ * and the last values.
+ */
+template <typename Engine, bool toExternal, typename Converter>
+struct SimdValidation {
+    using Input = typename MappingDirection<toExternal, Converter>::Input;
+    using Source = ConversionSource<
+        MappingDirection<toExternal, Converter>, Converter>;
+    using Kernels = ValidationKernels<Source>;
+
+    static std::size_t firstInvalid(const Input* input, std::size_t count)
+    { return firstInvalidWith(detectIsa(), input, count); }
+
+    /** Search with the kernel for `isa`, or the scalar code if there is
+     * none. Exposed for the tests.
+     */
+    static std::size_t firstInvalidWith(
+        Isa isa, const Input* input, std::size_t count) {
+        std::size_t i = 0;
+
+#if LGUIM_SEC_SIMD_X86
+        if (Kernels::supports(isa)) {
+            bool found = false;
+            i = Kernels::run(
+                isa, reinterpret_cast<const unsigned char*>(input), count,
+                found);
+            if (found) {
+                return i;
+            }
+        }
+#else
+        static_cast<void>(isa);
+#endif
+
+        for (; i < count; ++i) {
+            if (!Convertibility<Engine, toExternal, Converter>::test(
+                    input[i])) {
+                return i;
+            }
+        }
+        return count;
+    }
+};
+
+}  // namespace priv
+
+}  // namespace lguim
+
+#endif  // LGUIM_SECUREENUMCONVERTER_SIMD_H_
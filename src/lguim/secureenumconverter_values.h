@@ -0,0 +1,100 @@
+// Copyright 2019 Lucien Guimier <lucien.guimier@laposte.net>
+// Released according to the MIT terms. See attached LICENSE file.
+
+#ifndef LGUIM_SECUREENUMCONVERTER_VALUES_H_
+#define LGUIM_SECUREENUMCONVERTER_VALUES_H_
+
+#include <cstddef>
+#include <set>
+
+#include "lguim/secureenumconverter_engines.h"
+
+namespace lguim {
+
+/** Read-only view of sorted, unique values, as returned by
+ * `SecureEnumConverter::convertibleInternalSpan`.
+ *
+ * The viewed array is owned by the converter and lives for the whole
+ * program. Values are sorted with `operator<`, so membership is a binary
+ * search.
+ */
+template <typename T>
+class ValueSpan {
+ public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using const_iterator = const T*;
+    using iterator = const_iterator;
+
+    constexpr ValueSpan(const T* data, std::size_t size)
+        : data_(data), size_(size) {}
+
+    constexpr const T* data() const { return data_; }
+    constexpr std::size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+
+    constexpr const_iterator begin() const { return data_; }
+    constexpr const_iterator end() const { return data_ + size_; }
+
+    constexpr const T& operator[](std::size_t i) const { return data_[i]; }
+
+    constexpr bool contains(const T& value) const
+    { return contains(value, 0, size_); }
+
+    /** Copy of the values, for code working with `std::set`. */
+    std::set<T> toSet() const { return std::set<T>(begin(), end()); }
+
+ private:
+    constexpr bool contains(
+        const T& value, std::size_t begin, std::size_t end) const {
+        return end - begin == 0 ? false
+            : data_[begin + (end - begin) / 2] < value
+                ? contains(value, begin + (end - begin) / 2 + 1, end)
+            : value < data_[begin + (end - begin) / 2]
+                ? contains(value, begin, begin + (end - begin) / 2)
+            : true;
+    }
+
+    const T* data_;
+    std::size_t size_;
+};
+
+namespace priv {
+
+/** Array of the keys of a source, sorted, as values of type `Value`. */
+template <
+    typename Source, typename Value,
+    typename Ranks = typename MakeIndexSequence<
+        SortedLayout<Source>::tableSize>::Type
+>
+struct SortedValues;
+
+template <typename Source, typename Value, std::size_t... Ranks>
+struct SortedValues<Source, Value, IndexSequence<Ranks...>> {
+    using Layout = SortedLayout<Source>;
+
+    static constexpr Value values[sizeof...(Ranks)] = {
+        static_cast<Value>(Layout::key(Ranks))...
+    };
+
+    static constexpr ValueSpan<Value> span()
+    { return ValueSpan<Value>(values, Layout::count); }
+};
+
+template <typename Source, typename Value, std::size_t... Ranks>
+constexpr Value
+SortedValues<Source, Value, IndexSequence<Ranks...>>::values[
+    sizeof...(Ranks)];
+
+/** Sorted inputs of a conversion direction, computed from the rows. */
+template <bool toExternal, typename Converter>
+using SortedInputs = SortedValues<
+    ConversionSource<MappingDirection<toExternal, Converter>, Converter>,
+    typename MappingDirection<toExternal, Converter>::Input
+>;
+
+}  // namespace priv
+
+}  // namespace lguim
+
+#endif  // LGUIM_SECUREENUMCONVERTER_VALUES_H_
@@ -0,0 +1,26 @@
+#include "lguim/enumattributes.h"
+
+enum class A { A1, A2, A3 };
+enum class B { B1, B2, B3 };
+using SUT = lguim::SecureEnumConverter<A, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) \
+    SEC_EQUIV(A::A2, B::B2) \
+    SEC_EQUIV(A::A3, B::B3)
+#include "lguim/secureenumconverter.inc"
+
+#define SEC_TYPE SUT
+#define SEC_SIDE lguim::side::External
+#define SEC_COLUMNS \
+    SEC_COLUMN(priority, int)
+#define SEC_ATTRIBUTES \
+    SEC_ROW(B::B1, 1) \
+    SEC_ROW(B::B3, 3)
+#include "lguim/enumattributes.inc"
+
+int main() {
+    using Attributes = lguim::EnumAttributes<SUT, lguim::side::External>;
+    return Attributes::priority[Attributes::ordinalOf(B::B2)];
+}
@@ -0,0 +1,16 @@
+#include "lguim/secureenumconverter.h"
+
+enum class A { A1, A2, A3 };
+enum class B { B1, B2 };
+using SUT = lguim::SecureEnumConverter<A, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) \
+    SEC_EQUIV(A::A2, B::B2) \
+    SEC_ORPHAN_INT(A::A3)
+#include "lguim/secureenumconverter.inc"
+
+int main() {
+    constexpr B b = SUT::externalOf<A::A3>();
+}
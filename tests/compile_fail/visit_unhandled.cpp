@@ -0,0 +1,22 @@
+#include "lguim/enumvisit.h"
+
+enum class A { A1, A2, A3 };
+enum class B { B1, B2, B3 };
+using SUT = lguim::SecureEnumConverter<A, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) \
+    SEC_EQUIV(A::A2, B::B2) \
+    SEC_EQUIV(A::A3, B::B3)
+#include "lguim/secureenumconverter.inc"
+
+struct Handler {
+    int operator()(lguim::EnumConstant<B, B::B1>) { return 1; }
+    int operator()(lguim::EnumConstant<B, B::B2>) { return 2; }
+};
+
+int main() {
+    return lguim::visit<SUT, lguim::side::External>(
+        A::A3, Handler(), [](A) { return 0; });
+}
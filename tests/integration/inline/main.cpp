@@ -0,0 +1,31 @@
+#include "assertions.h"
+#include "sut.h"
+
+START_TEST(IntegrationInline)
+    // toExternalOpt
+    COMPARE_EQ(SUT::toExternalOpt(A::A1), B::B1);
+    COMPARE_EQ(SUT::toExternalOpt(A::A2), B::B2);
+    COMPARE_EQ(SUT::toExternalOpt(A::A3), B::B3);
+    COMPARE_EQ(SUT::toExternalOpt(A::A4), SEC_OPTIONAL_NS::nullopt);
+    COMPARE_EQ(SUT::toExternalOpt(A::A2_old), B::B2);
+
+    // toInternalOpt
+    COMPARE_EQ(SUT::toInternalOpt(B::B1), A::A1);
+    COMPARE_EQ(SUT::toInternalOpt(B::B2), A::A2);
+    COMPARE_EQ(SUT::toInternalOpt(B::B3), A::A3);
+    COMPARE_EQ(SUT::toInternalOpt(B::B5), SEC_OPTIONAL_NS::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(B::B3_old), A::A3);
+
+    // Conversions from the other translation unit
+    COMPARE_EQ(roundTrip(B::B1), B::B1);
+    COMPARE_EQ(roundTrip(B::B3_old), B::B3);
+    THROWS(std::invalid_argument, roundTrip(B::B5));
+
+    // convertibleInternalValues
+    std::set<A> expectedInternalValues { A::A1, A::A2, A::A3, A::A2_old };
+    COMPARE_EQ(SUT::convertibleInternalValues(), expectedInternalValues);
+
+    // convertibleInternalValues
+    std::set<B> expectedExternalValues { B::B1, B::B2, B::B3, B::B3_old };
+    COMPARE_EQ(SUT::convertibleExternalValues(), expectedExternalValues);
+END_TEST
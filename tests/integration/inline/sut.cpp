@@ -0,0 +1,5 @@
+#include "sut.h"
+
+B roundTrip(B external) {
+    return SUT::toExternalOrThrow(SUT::toInternalOrThrow(external));
+}
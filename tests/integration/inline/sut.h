@@ -0,0 +1,31 @@
+#ifndef SUT_H
+#define SUT_H
+
+#if __cplusplus < 201703L
+#include "nonstd/optional.hpp"
+#define SEC_OPTIONAL_NS nonstd
+#endif
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A { A1, A2, A3, A4, A2_old };
+enum class B { B1, B2, B3, B5, B3_old };
+using SUT = lguim::SecureEnumConverter<A, B>;
+
+#define SEC_TYPE SUT
+#define SEC_INLINE
+#define SEC_MAPPING                \
+    SEC_EQUIV(A::A1, B::B1)        \
+    SEC_EQUIV(A::A2, B::B2)        \
+    SEC_PROJ_I2E(A::A2_old, B::B2) \
+    SEC_PROJ_E2I(A::A3, B::B3_old) \
+    SEC_EQUIV(A::A3, B::B3)        \
+    SEC_ORPHAN_INT(A::A4)          \
+    SEC_ORPHAN_EXT(B::B5)
+#include "lguim/secureenumconverter.inc"
+
+// Defined in another translation unit, also using the inline mapping.
+B roundTrip(B external);
+
+#endif // SUT_H
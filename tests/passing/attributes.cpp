@@ -0,0 +1,82 @@
+#include <cstdint>
+#include <cstring>
+
+#include "assertions.h"
+#include "lguim/enumattributes.h"
+
+enum class A : std::uint8_t { A1, A2, A2_old, A3, A4 }; struct TA;
+enum class B : std::int32_t { B1 = 3000, B2 = -200, B3 = 10, B4 = 4 };
+struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+enum class Retry { Never, Once, Always };
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) \
+    SEC_EQUIV(A::A2, B::B2) \
+    SEC_PROJ_I2E(A::A2_old, B::B2) \
+    SEC_EQUIV(A::A3, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+#define SEC_TYPE SUT
+#define SEC_SIDE TB
+#define SEC_COLUMNS \
+    SEC_COLUMN(priority, int) \
+    SEC_COLUMN(name, const char*) \
+    SEC_COLUMN(retry, Retry)
+#define SEC_ATTRIBUTES \
+    SEC_ROW(B::B4, 4, "four", Retry::Never) \
+    SEC_ROW(B::B1, 1, "one", Retry::Always) \
+    SEC_ROW(B::B3, 3, "three", Retry::Once) \
+    SEC_ROW(B::B2, 2, "two", Retry::Never)
+#include "lguim/enumattributes.inc"
+
+#define SEC_TYPE SUT
+#define SEC_SIDE lguim::side::Internal
+#define SEC_COLUMNS \
+    SEC_COLUMN(weight, std::uint16_t)
+#define SEC_ATTRIBUTES \
+    SEC_ROW(A::A1, 10) \
+    SEC_ROW(A::A2, 20) \
+    SEC_ROW(A::A2_old, 21) \
+    SEC_ROW(A::A3, 30) \
+    SEC_ROW(A::A4, 40)
+#include "lguim/enumattributes.inc"
+
+using External = lguim::EnumAttributes<SUT, lguim::side::External>;
+using Internal = lguim::EnumAttributes<SUT, TA>;
+
+static_assert(External::priority[0] == 2, "Columns are constant");
+static_assert(External::retry[External::size] == Retry::Never, "Last entry");
+
+START_TEST(Attributes)
+    COMPARE_EQ(External::size, 4u);
+
+    // By ordinal: B2, B4, B3, B1
+    COMPARE_EQ(External::priority[0], 2);
+    COMPARE_EQ(External::priority[1], 4);
+    COMPARE_EQ(External::priority[2], 3);
+    COMPARE_EQ(External::priority[3], 1);
+    COMPARE_EQ(External::priority[4], 0);
+    ASSERT(External::name[4] == nullptr);
+
+    COMPARE_EQ(External::priority[External::ordinalOf(B::B3)], 3);
+    COMPARE_EQ(
+        std::strcmp(External::name[External::ordinalOf(B::B1)], "one"), 0);
+    COMPARE_EQ(External::ordinalOf(static_cast<B>(5)), External::size);
+
+    // Attributes of the conversion
+    COMPARE_EQ(External::priority[External::conversionOrdinal(A::A2_old)], 2);
+    COMPARE_EQ(
+        External::retry[External::conversionOrdinal(A::A1)], Retry::Always);
+    COMPARE_EQ(External::conversionOrdinal(A::A4), External::size);
+    COMPARE_EQ(External::priority[External::conversionOrdinal(A::A4)], 0);
+
+    // Attributes of the other side
+    COMPARE_EQ(Internal::weight[Internal::ordinalOf(A::A2_old)], 21);
+    COMPARE_EQ(Internal::weight[Internal::conversionOrdinal(B::B2)], 20);
+    COMPARE_EQ(Internal::conversionOrdinal(B::B4), Internal::size);
+END_TEST
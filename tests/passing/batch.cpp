@@ -0,0 +1,68 @@
+#include <cstdint>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A : std::uint16_t { A1, A2, A3, A4 }; struct TA;
+enum class B : std::int16_t { B1 = 10, B2 = 20, B3 = 30, B4 = 40 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_EQUIV(A::A3, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+START_TEST(Batch)
+    // All values converted
+    const std::vector<A> internal { A::A1, A::A2, A::A3, A::A1 };
+    std::vector<B> external(internal.size());
+    lguim::BatchResult result = SUT::toExternalBatch(
+        internal.data(), internal.size(), external.data());
+    ASSERT(result.ok());
+    COMPARE_EQ(result.invalidCount, 0u);
+    COMPARE_EQ(result.firstInvalid, 4u);
+    COMPARE_EQ(external, (std::vector<B> { B::B2, B::B1, B::B3, B::B2 }));
+
+    // Invalid values are counted, their outputs are untouched
+    const std::vector<B> withOrphans { B::B1, B::B4, B::B2, B::B4 };
+    std::vector<A> converted(withOrphans.size(), A::A4);
+    result = SUT::toInternalBatch(
+        withOrphans.data(), withOrphans.size(), converted.data());
+    ASSERT(!result.ok());
+    COMPARE_EQ(result.invalidCount, 2u);
+    COMPARE_EQ(result.firstInvalid, 1u);
+    COMPARE_EQ(converted, (std::vector<A> { A::A2, A::A4, A::A1, A::A4 }));
+
+    // Tagged and half converters
+    std::vector<B> tagged(internal.size());
+    result = SUT::convertBatch<TB>(
+        internal.data(), internal.size(), tagged.data());
+    ASSERT(result.ok());
+    COMPARE_EQ(tagged, external);
+    result = SUT::HalfConverter<TA>::convertBatch(
+        withOrphans.data(), withOrphans.size(), converted.data());
+    COMPARE_EQ(result.firstInvalid, 1u);
+
+    // In place, on more than one chunk
+    std::vector<A> values;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        values.push_back(i == 600 || i == 900 ? A::A4 : A::A3);
+    }
+    result = SUT::toExternalInPlace(values.data(), values.size());
+    COMPARE_EQ(result.invalidCount, 2u);
+    COMPARE_EQ(result.firstInvalid, 600u);
+    const B* inPlace = reinterpret_cast<const B*>(values.data());
+    COMPARE_EQ(inPlace[0], B::B3);
+    COMPARE_EQ(inPlace[999], B::B3);
+    COMPARE_EQ(values[600], A::A4);
+
+    std::vector<B> backward { B::B1, B::B2 };
+    result = SUT::convertInPlace<TA>(backward.data(), backward.size());
+    ASSERT(result.ok());
+    COMPARE_EQ(reinterpret_cast<const A*>(backward.data())[1], A::A1);
+END_TEST
@@ -0,0 +1,155 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/enumcodes.h"
+
+enum class Status : std::uint8_t { Ok, Busy, Refused, Unknown };
+enum class WireStatus : std::uint16_t {
+    Ok = 0x0100, Busy = 0x0102, Refused = 0x0200, Legacy = 0x0300,
+};
+using SUT = lguim::SecureEnumConverter<Status, WireStatus>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(Status::Ok, WireStatus::Ok) \
+    SEC_EQUIV(Status::Busy, WireStatus::Busy) \
+    SEC_EQUIV(Status::Refused, WireStatus::Refused) \
+    SEC_ORPHAN_INT(Status::Unknown) \
+    SEC_ORPHAN_EXT(WireStatus::Legacy)
+#include "lguim/secureenumconverter.inc"
+
+enum class Delta : std::int16_t { Down = -1, Same = 0, Up = 1 };
+using Signed = lguim::SecureEnumConverter<Status, Delta>;
+
+#define SEC_TYPE Signed
+#define SEC_MAPPING \
+    SEC_EQUIV(Status::Refused, Delta::Down) \
+    SEC_EQUIV(Status::Ok, Delta::Same) \
+    SEC_EQUIV(Status::Busy, Delta::Up) \
+    SEC_ORPHAN_INT(Status::Unknown)
+#include "lguim/secureenumconverter.inc"
+
+// Packets of 5 bytes, with the big-endian status at offset 1
+std::vector<unsigned char> packets(const std::vector<std::uint16_t>& codes) {
+    std::vector<unsigned char> bytes;
+    for (std::uint16_t code : codes) {
+        bytes.push_back(0xee);
+        bytes.push_back(static_cast<unsigned char>(code >> 8));
+        bytes.push_back(static_cast<unsigned char>(code & 0xff));
+        bytes.push_back(0xee);
+        bytes.push_back(0xee);
+    }
+    return bytes;
+}
+
+START_TEST(Codes)
+    const lguim::CodeLayout bigStatus{2, lguim::ByteOrder::Big, 5};
+
+    // Big-endian fields at a stride, across blocks of 64
+    std::vector<std::uint16_t> codes;
+    for (std::size_t i = 0; i < 150; ++i) {
+        codes.push_back(i % 3 == 0 ? 0x0102 : 0x0100);
+    }
+    codes[70] = 0x0300;
+    codes[71] = 0x0201;
+    codes[149] = 0x0002;
+    const std::vector<unsigned char> bytes = packets(codes);
+
+    std::vector<Status> output(150, Status::Unknown);
+    std::vector<std::uint8_t> validity(19, 0xff);
+    const lguim::BatchResult result = lguim::decodeCodes<SUT>(
+        bytes.data() + 1, bigStatus, 150, output.data(), validity.data());
+
+    COMPARE_EQ(result.invalidCount, 3u);
+    COMPARE_EQ(result.firstInvalid, 70u);
+    COMPARE_EQ(output[0], Status::Busy);
+    COMPARE_EQ(output[1], Status::Ok);
+    COMPARE_EQ(output[69], Status::Busy);
+    COMPARE_EQ(output[70], Status::Unknown);
+    COMPARE_EQ(output[71], Status::Unknown);
+    COMPARE_EQ(output[148], Status::Ok);
+    COMPARE_EQ(output[149], Status::Unknown);
+    COMPARE_EQ(validity[0], 0xffu);
+    COMPARE_EQ(validity[8], 0x3fu);
+    COMPARE_EQ(validity[18], 0x1fu);
+
+    // Big-endian contiguous fields, swapped as a whole: same results
+    std::vector<unsigned char> contiguous;
+    for (std::uint16_t code : codes) {
+        contiguous.push_back(static_cast<unsigned char>(code >> 8));
+        contiguous.push_back(static_cast<unsigned char>(code & 0xff));
+    }
+    std::vector<Status> fromContiguous(150, Status::Unknown);
+    std::vector<std::uint8_t> contiguousValidity(19, 0xff);
+    const lguim::BatchResult contiguousResult = lguim::decodeCodes<SUT>(
+        contiguous.data(), {2, lguim::ByteOrder::Big, 2}, 150,
+        fromContiguous.data(), contiguousValidity.data());
+    COMPARE_EQ(contiguousResult.invalidCount, 3u);
+    COMPARE_EQ(contiguousResult.firstInvalid, 70u);
+    ASSERT(fromContiguous == output);
+    ASSERT(contiguousValidity == validity);
+
+    // Little-endian contiguous fields, same bytes swapped
+    const unsigned char little[] = { 0x02, 0x01, 0x01, 0x02, 0x00, 0x02 };
+    Status fromLittle[3] = {
+        Status::Unknown, Status::Unknown, Status::Unknown,
+    };
+    const lguim::BatchResult littleResult = lguim::decodeCodes<SUT>(
+        little, {2, lguim::ByteOrder::Little, 2}, 3, fromLittle, nullptr);
+    COMPARE_EQ(littleResult.invalidCount, 1u);
+    COMPARE_EQ(fromLittle[0], Status::Busy);
+    COMPARE_EQ(fromLittle[1], Status::Unknown);
+    COMPARE_EQ(fromLittle[2], Status::Refused);
+
+    // Wider fields: not truncated
+    const unsigned char wide[] = {
+        0x00, 0x00, 0x01, 0x00,
+        0x00, 0x01, 0x01, 0x00,
+        0xff, 0xff, 0x02, 0x00,
+    };
+    Status fromWide[3] = { Status::Unknown, Status::Unknown, Status::Unknown };
+    std::uint8_t wideValidity = 0xff;
+    const lguim::BatchResult wideResult = lguim::decodeCodes<SUT>(
+        wide, {4, lguim::ByteOrder::Big, 4}, 3, fromWide, &wideValidity);
+    COMPARE_EQ(wideResult.invalidCount, 2u);
+    COMPARE_EQ(wideResult.firstInvalid, 1u);
+    COMPARE_EQ(fromWide[0], Status::Ok);
+    COMPARE_EQ(fromWide[1], Status::Unknown);
+    COMPARE_EQ(wideValidity, 0x1u);
+
+    // Narrower signed fields are sign-extended, wider ones range-checked
+    const unsigned char deltas[] = { 0xff, 0x00, 0x01, 0x02, 0x80 };
+    Status fromDeltas[5] = {};
+    const lguim::BatchResult deltaResult = lguim::decodeCodes<Signed>(
+        deltas, {1, lguim::ByteOrder::Big, 1}, 5, fromDeltas, nullptr);
+    COMPARE_EQ(deltaResult.invalidCount, 2u);
+    COMPARE_EQ(fromDeltas[0], Status::Refused);
+    COMPARE_EQ(fromDeltas[1], Status::Ok);
+    COMPARE_EQ(fromDeltas[2], Status::Busy);
+
+    const unsigned char wideDeltas[] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x01,
+    };
+    Status fromWideDeltas[2] = { Status::Unknown, Status::Unknown };
+    const lguim::BatchResult wideDeltaResult = lguim::decodeCodes<Signed>(
+        wideDeltas, {8, lguim::ByteOrder::Big, 8}, 2, fromWideDeltas,
+        nullptr);
+    COMPARE_EQ(wideDeltaResult.invalidCount, 1u);
+    COMPARE_EQ(fromWideDeltas[0], Status::Refused);
+    COMPARE_EQ(fromWideDeltas[1], Status::Unknown);
+
+    // std::byte buffers
+    const std::byte byteBuffer[] = { std::byte{0x02}, std::byte{0x00} };
+    Status fromBytes = Status::Unknown;
+    const lguim::BatchResult byteResult = lguim::decodeCodes<SUT>(
+        byteBuffer, {2, lguim::ByteOrder::Big, 2}, 1, &fromBytes, nullptr);
+    ASSERT(byteResult.ok());
+    COMPARE_EQ(fromBytes, Status::Refused);
+
+    THROWS(std::invalid_argument, lguim::decodeCodes<SUT>(
+        little, {3, lguim::ByteOrder::Big, 3}, 1, fromLittle, nullptr));
+END_TEST
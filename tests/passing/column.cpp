@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A : std::uint8_t { A1, A2, A3, A4 }; struct TA;
+enum class B : std::uint8_t { B1 = 10, B2 = 20, B3 = 30, B4 = 40 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_EQUIV(A::A3, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+bool isSet(const std::vector<std::uint8_t>& bitmap, std::size_t i) {
+    return (bitmap[i / 8] >> (i % 8)) & 1;
+}
+
+START_TEST(Column)
+    // Without input bitmap: orphans become nulls
+    const std::vector<A> small { A::A1, A::A4, A::A3, A::A2, A::A4 };
+    std::vector<B> external(small.size(), B::B4);
+    std::vector<std::uint8_t> validity(1, 0xFF);
+    lguim::ColumnResult result = SUT::toExternalColumn(
+        small.data(), nullptr, small.size(), external.data(), validity.data());
+    COMPARE_EQ(result.nullCount, 2u);
+    COMPARE_EQ(result.invalidCount, 2u);
+    COMPARE_EQ(result.firstInvalid, 1u);
+    COMPARE_EQ(validity[0], 0x0Du);  // Last bits cleared
+    COMPARE_EQ(
+        external, (std::vector<B> { B::B2, B::B4, B::B3, B::B1, B::B4 }));
+
+    // Several blocks, with an input bitmap
+    std::vector<A> internal;
+    std::vector<std::uint8_t> inputValidity(25, 0);
+    for (std::size_t i = 0; i < 200; ++i) {
+        internal.push_back(static_cast<A>(i % 4));
+        if (i % 5 != 0) {
+            inputValidity[i / 8] |= 1 << (i % 8);
+        }
+    }
+
+    external.assign(internal.size(), B::B4);
+    std::vector<std::uint8_t> outputValidity(25, 0xFF);
+    result = SUT::convertColumn<TB>(
+        internal.data(), inputValidity.data(), internal.size(),
+        external.data(), outputValidity.data());
+
+    // Nulls: multiples of 5, and A4 (i % 4 == 3) when not already null
+    std::size_t nulls = 0;
+    std::size_t invalid = 0;
+    bool bitsMatch = true;
+    bool valuesMatch = true;
+    for (std::size_t i = 0; i < internal.size(); ++i) {
+        const bool expected = i % 5 != 0 && i % 4 != 3;
+        nulls += expected ? 0 : 1;
+        invalid += i % 5 != 0 && i % 4 == 3 ? 1 : 0;
+        bitsMatch = bitsMatch && isSet(outputValidity, i) == expected;
+        valuesMatch = valuesMatch
+            && (!expected
+                || external[i] == SUT::toExternalOrThrow(internal[i]));
+    }
+    ASSERT(bitsMatch);
+    ASSERT(valuesMatch);
+    COMPARE_EQ(result.nullCount, nulls);
+    COMPARE_EQ(result.invalidCount, invalid);
+    COMPARE_EQ(result.firstInvalid, 3u);
+    COMPARE_EQ(outputValidity[24], 0x77u);
+
+    // Orphans in null rows are not reported
+    std::vector<std::uint8_t> hideOrphans(25, 0);
+    for (std::size_t i = 0; i < internal.size(); ++i) {
+        if (i % 4 != 3) {
+            hideOrphans[i / 8] |= 1 << (i % 8);
+        }
+    }
+    result = SUT::toExternalColumn(
+        internal.data(), hideOrphans.data(), internal.size(),
+        external.data(), outputValidity.data());
+    ASSERT(result.ok());
+    COMPARE_EQ(result.nullCount, 50u);
+    COMPARE_EQ(result.firstInvalid, 200u);
+    COMPARE_EQ(outputValidity, hideOrphans);
+
+    // Other direction
+    const std::vector<B> wire { B::B4, B::B1, B::B2 };
+    std::vector<A> back(wire.size(), A::A4);
+    result = SUT::HalfConverter<TA>::convertColumn(
+        wire.data(), nullptr, wire.size(), back.data(), validity.data());
+    COMPARE_EQ(result.nullCount, 1u);
+    COMPARE_EQ(result.firstInvalid, 0u);
+    COMPARE_EQ(validity[0], 0x06u);
+    COMPARE_EQ(back, (std::vector<A> { A::A4, A::A2, A::A1 }));
+END_TEST
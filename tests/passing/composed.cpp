@@ -0,0 +1,118 @@
+#include <cstdint>
+#include <stdexcept>
+
+#include "assertions.h"
+#include "lguim/composedconverter.h"
+
+enum class Domain : std::uint8_t { D1, D2, D2_old, D3, D4, D5 };
+enum class Canonical : std::uint16_t { C1 = 10, C2 = 20, C3 = 30, C4 = 40 };
+enum class Wire : std::int32_t { W1 = -1, W2 = 700, W3 = 12, W4 = 5 };
+struct TDomain;
+struct TCanonical;
+struct TWire;
+
+using First = lguim::TaggedEnumConverter<
+    TDomain, Domain, TCanonical, Canonical>;
+
+#define SEC_TYPE First
+#define SEC_MAPPING \
+    SEC_EQUIV(Domain::D1, Canonical::C1) \
+    SEC_EQUIV(Domain::D2, Canonical::C2) \
+    SEC_PROJ_I2E(Domain::D2_old, Canonical::C2) \
+    SEC_EQUIV(Domain::D3, Canonical::C3) \
+    SEC_EQUIV(Domain::D4, Canonical::C4) \
+    SEC_ORPHAN_INT(Domain::D5)
+#include "lguim/secureenumconverter.inc"
+
+// Wire as the internal type: the shared type is external on both sides
+using Second = lguim::TaggedEnumConverter<TWire, Wire, TCanonical, Canonical>;
+
+#define SEC_TYPE Second
+#define SEC_MAPPING \
+    SEC_EQUIV(Wire::W1, Canonical::C1) \
+    SEC_EQUIV(Wire::W2, Canonical::C2) \
+    SEC_EQUIV(Wire::W3, Canonical::C3) \
+    SEC_ORPHAN_EXT(Canonical::C4) \
+    SEC_ORPHAN_INT(Wire::W4)
+#include "lguim/secureenumconverter.inc"
+
+using SUT = lguim::ComposedConverter<First, Second>;
+
+// Chain in the usual orientation, A to B then B to C
+enum class A : std::uint8_t { A1, A2 };
+enum class B : std::uint8_t { B1, B2 };
+enum class C : std::uint8_t { C1 = 4, C2 = 5 };
+
+using AB = lguim::SecureEnumConverter<A, B>;
+using BC = lguim::SecureEnumConverter<B, C>;
+
+#define SEC_TYPE AB
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) \
+    SEC_EQUIV(A::A2, B::B2)
+#include "lguim/secureenumconverter.inc"
+
+#define SEC_TYPE BC
+#define SEC_MAPPING \
+    SEC_EQUIV(B::B1, C::C1) \
+    SEC_EQUIV(B::B2, C::C2)
+#include "lguim/secureenumconverter.inc"
+
+using AC = lguim::ComposedConverter<AB, BC>;
+
+START_TEST(Composed)
+    ASSERT(std::is_same<SUT::Internal, Domain>::value);
+    ASSERT(std::is_same<SUT::Middle, Canonical>::value);
+    ASSERT(std::is_same<SUT::External, Wire>::value);
+
+    COMPARE_EQ(SUT::toExternalOpt(Domain::D1), Wire::W1);
+    COMPARE_EQ(SUT::toExternalOpt(Domain::D2), Wire::W2);
+    COMPARE_EQ(SUT::toExternalOpt(Domain::D2_old), Wire::W2);
+    COMPARE_EQ(SUT::toExternalOpt(Domain::D3), Wire::W3);
+
+    // Orphans of the second mapping, of the first one, and unknown values
+    ASSERT(!SUT::toExternalOpt(Domain::D4));
+    ASSERT(!SUT::toExternalOpt(Domain::D5));
+    ASSERT(!SUT::toExternalOpt(static_cast<Domain>(42)));
+
+    COMPARE_EQ(SUT::toInternalOpt(Wire::W1), Domain::D1);
+    COMPARE_EQ(SUT::toInternalOpt(Wire::W2), Domain::D2);
+    COMPARE_EQ(SUT::toInternalOpt(Wire::W3), Domain::D3);
+    ASSERT(!SUT::toInternalOpt(Wire::W4));
+    ASSERT(!SUT::toInternalOpt(static_cast<Wire>(13)));
+
+    COMPARE_EQ(SUT::toExternalOrThrow(Domain::D3), Wire::W3);
+    THROWS(std::invalid_argument, SUT::toExternalOrThrow(Domain::D4));
+    THROWS(std::invalid_argument, SUT::toInternalOrThrow(Wire::W4));
+
+    // Direction by the tags of the outer types, or by side
+    COMPARE_EQ(SUT::convertOpt<TWire>(Domain::D2_old), Wire::W2);
+    COMPARE_EQ(SUT::convertOpt<TDomain>(Wire::W3), Domain::D3);
+    COMPARE_EQ(
+        SUT::convertOrThrow<lguim::side::Internal>(Wire::W1), Domain::D1);
+    THROWS(std::invalid_argument, SUT::convertOrThrow<TWire>(Domain::D5));
+
+    const Domain inputs[] = {
+        Domain::D1, Domain::D4, Domain::D2_old, Domain::D5, Domain::D3
+    };
+    Wire outputs[5] = {};
+    const lguim::BatchResult result =
+        SUT::convertBatch<lguim::side::External>(inputs, 5, outputs);
+    COMPARE_EQ(result.invalidCount, 2u);
+    COMPARE_EQ(result.firstInvalid, 1u);
+    COMPARE_EQ(outputs[0], Wire::W1);
+    COMPARE_EQ(outputs[2], Wire::W2);
+    COMPARE_EQ(outputs[4], Wire::W3);
+
+    const Wire wires[] = {Wire::W3, Wire::W1};
+    Domain domains[2] = {};
+    ASSERT(SUT::toInternalBatch(wires, 2, domains).ok());
+    COMPARE_EQ(domains[0], Domain::D3);
+    COMPARE_EQ(domains[1], Domain::D1);
+
+    // The fused conversions are constant offsets here
+    COMPARE_EQ(AC::toExternalOpt(A::A2), C::C2);
+    COMPARE_EQ(AC::toInternalOpt(C::C1), A::A1);
+    ASSERT(!AC::toInternalOpt(static_cast<C>(6)));
+    COMPARE_EQ(AC::tableBytes(), 0u);
+END_TEST
@@ -0,0 +1,60 @@
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A { A1, A2, A3, A4 }; struct TA;
+enum class B { B1, B2, B3, B4 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_PROJ_I2E(A::A3, B::B1) \
+    SEC_PROJ_E2I(A::A2, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+// Conversions of constants are constant expressions.
+static_assert(SUT::externalOf<A::A1>() == B::B2, "A1 → B2");
+static_assert(SUT::externalOf<A::A3>() == B::B1, "A3 → B1");
+static_assert(SUT::internalOf<B::B1>() == A::A2, "B1 → A2");
+static_assert(SUT::internalOf<B::B3>() == A::A2, "B3 → A2");
+static_assert(SUT::convertOf<TB, A::A2>() == B::B1, "A2 → B1");
+static_assert(SUT::convertOf<TA, B::B2>() == A::A1, "B2 → A1");
+static_assert(lguim::convert_v<SUT, TB, A::A1> == B::B2, "A1 → B2");
+static_assert(lguim::convert_v<SUT, TA, B::B3> == A::A2, "B3 → A2");
+
+// They can be used as template arguments and in static tables.
+template <B value>
+struct ExternalConstant { static constexpr B get() { return value; } };
+
+static_assert(
+    ExternalConstant<SUT::externalOf<A::A2>()>::get() == B::B1,
+    "A2 → B1");
+
+constexpr B defaults[] = {
+    SUT::convertOf<TB, A::A1>(),
+    SUT::convertOf<TB, A::A2>(),
+    SUT::convertOf<TB, A::A3>(),
+};
+
+START_TEST(ConvertV)
+    COMPARE_EQ(SUT::externalOf<A::A1>(), B::B2);
+    COMPARE_EQ(SUT::externalOf<A::A2>(), B::B1);
+    COMPARE_EQ(SUT::externalOf<A::A3>(), B::B1);
+
+    COMPARE_EQ(SUT::internalOf<B::B1>(), A::A2);
+    COMPARE_EQ(SUT::internalOf<B::B2>(), A::A1);
+    COMPARE_EQ(SUT::internalOf<B::B3>(), A::A2);
+
+    COMPARE_EQ(defaults[0], B::B2);
+    COMPARE_EQ(defaults[1], B::B1);
+    COMPARE_EQ(defaults[2], B::B1);
+
+    // Same results as the runtime conversions.
+    constexpr B b = lguim::convert_v<SUT, TB, A::A1>;
+    COMPARE_EQ(b, SUT::convertOrThrow<TB>(A::A1));
+    constexpr A a = lguim::convert_v<SUT, TA, B::B3>;
+    COMPARE_EQ(a, SUT::convertOrThrow<TA>(B::B3));
+END_TEST
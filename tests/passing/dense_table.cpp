@@ -0,0 +1,62 @@
+#include <cstdint>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A : std::int8_t { A1 = -2, A2 = 0, A3 = 1, A4 = 5, A2_old = 6 };
+enum class B : std::uint8_t { B1 = 3, B2, B3, B5 = 10, B3_old = 255 };
+using SUT = lguim::SecureEnumConverter<A, B>;
+
+#define SEC_TYPE SUT
+#define SEC_ENGINE lguim::engine::DenseTable
+#define SEC_MAPPING                \
+    SEC_EQUIV(A::A1, B::B1)        \
+    SEC_EQUIV(A::A2, B::B2)        \
+    SEC_PROJ_I2E(A::A2_old, B::B2) \
+    SEC_PROJ_E2I(A::A3, B::B3_old) \
+    SEC_EQUIV(A::A3, B::B3)        \
+    SEC_ORPHAN_INT(A::A4)          \
+    SEC_ORPHAN_EXT(B::B5)
+#include "lguim/secureenumconverter.inc"
+
+START_TEST(DenseTable)
+    // toExternalOpt
+    COMPARE_EQ(SUT::toExternalOpt(A::A1), B::B1);
+    COMPARE_EQ(SUT::toExternalOpt(A::A2), B::B2);
+    COMPARE_EQ(SUT::toExternalOpt(A::A3), B::B3);
+    COMPARE_EQ(SUT::toExternalOpt(A::A4), std::nullopt);
+    COMPARE_EQ(SUT::toExternalOpt(A::A2_old), B::B2);
+
+    // toExternalOpt, values absent from the mapping
+    COMPARE_EQ(SUT::toExternalOpt(static_cast<A>(-1)), std::nullopt);
+    COMPARE_EQ(SUT::toExternalOpt(static_cast<A>(-128)), std::nullopt);
+    COMPARE_EQ(SUT::toExternalOpt(static_cast<A>(127)), std::nullopt);
+
+    // toInternalOpt
+    COMPARE_EQ(SUT::toInternalOpt(B::B1), A::A1);
+    COMPARE_EQ(SUT::toInternalOpt(B::B2), A::A2);
+    COMPARE_EQ(SUT::toInternalOpt(B::B3), A::A3);
+    COMPARE_EQ(SUT::toInternalOpt(B::B5), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(B::B3_old), A::A3);
+
+    // toInternalOpt, values absent from the mapping
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(0)), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(6)), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(254)), std::nullopt);
+
+    // toExternalOrThrow
+    COMPARE_EQ(SUT::toExternalOrThrow(A::A1), B::B1);
+    THROWS(std::invalid_argument, SUT::toExternalOrThrow(A::A4));
+
+    // toInternalOrThrow
+    COMPARE_EQ(SUT::toInternalOrThrow(B::B3_old), A::A3);
+    THROWS(std::invalid_argument, SUT::toInternalOrThrow(B::B5));
+
+    // convertibleInternalValues
+    std::set<A> expectedInternalValues { A::A1, A::A2, A::A3, A::A2_old };
+    COMPARE_EQ(SUT::convertibleInternalValues(), expectedInternalValues);
+
+    // convertibleInternalValues
+    std::set<B> expectedExternalValues { B::B1, B::B2, B::B3, B::B3_old };
+    COMPARE_EQ(SUT::convertibleExternalValues(), expectedExternalValues);
+END_TEST
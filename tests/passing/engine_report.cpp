@@ -0,0 +1,116 @@
+#include <cstdint>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+using lguim::EngineKind;
+using lguim::EngineReport;
+
+enum class A : std::uint8_t { A1, A2, A3, A4, A5, A6, A7, A8, A9 };
+enum class B : std::uint8_t { B1, B2, B3, B4, B5, B6, B7, B8, B9 };
+enum class C : std::int32_t {
+    C1 = 1, C2 = 10, C3 = 100, C4 = 1000, C5 = 10000,
+    C6 = 100000, C7 = 1000000, C8 = 10000000, C9 = 100000000
+};
+
+// Identity in both directions
+using Identity = lguim::SecureEnumConverter<A, B, struct IdentityTag>;
+
+#define SEC_TYPE Identity
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) SEC_EQUIV(A::A2, B::B2) SEC_EQUIV(A::A3, B::B3) \
+    SEC_EQUIV(A::A4, B::B4) SEC_EQUIV(A::A5, B::B5) SEC_EQUIV(A::A6, B::B6) \
+    SEC_EQUIV(A::A7, B::B7) SEC_EQUIV(A::A8, B::B8) SEC_EQUIV(A::A9, B::B9)
+#include "lguim/secureenumconverter.inc"
+
+// Permutation to external, gaps to internal
+using Shuffled = lguim::SecureEnumConverter<A, B, struct ShuffledTag>;
+
+#define SEC_TYPE Shuffled
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B9) SEC_EQUIV(A::A2, B::B2) SEC_EQUIV(A::A3, B::B1) \
+    SEC_EQUIV(A::A4, B::B4) SEC_EQUIV(A::A5, B::B5) SEC_EQUIV(A::A6, B::B8) \
+    SEC_PROJ_I2E(A::A7, B::B8) SEC_ORPHAN_INT(A::A8) SEC_ORPHAN_INT(A::A9) \
+    SEC_ORPHAN_EXT(B::B3) SEC_ORPHAN_EXT(B::B6) SEC_ORPHAN_EXT(B::B7)
+#include "lguim/secureenumconverter.inc"
+
+// Sparse external values
+using Sparse = lguim::SecureEnumConverter<A, C, struct SparseTag>;
+
+#define SEC_TYPE Sparse
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, C::C1) SEC_EQUIV(A::A2, C::C2) SEC_EQUIV(A::A3, C::C3) \
+    SEC_EQUIV(A::A4, C::C4) SEC_EQUIV(A::A5, C::C5) SEC_EQUIV(A::A6, C::C6) \
+    SEC_EQUIV(A::A7, C::C7) SEC_EQUIV(A::A8, C::C8) SEC_EQUIV(A::A9, C::C9)
+#include "lguim/secureenumconverter.inc"
+
+// Few sparse values
+using Small = lguim::SecureEnumConverter<A, C, struct SmallTag>;
+
+#define SEC_TYPE Small
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, C::C1) SEC_EQUIV(A::A2, C::C9) \
+    SEC_ORPHAN_INT(A::A3) SEC_ORPHAN_INT(A::A4) SEC_ORPHAN_INT(A::A5) \
+    SEC_ORPHAN_INT(A::A6) SEC_ORPHAN_INT(A::A7) SEC_ORPHAN_INT(A::A8) \
+    SEC_ORPHAN_INT(A::A9) SEC_ORPHAN_EXT(C::C2) SEC_ORPHAN_EXT(C::C3) \
+    SEC_ORPHAN_EXT(C::C4) SEC_ORPHAN_EXT(C::C5) SEC_ORPHAN_EXT(C::C6) \
+    SEC_ORPHAN_EXT(C::C7) SEC_ORPHAN_EXT(C::C8)
+#include "lguim/secureenumconverter.inc"
+
+// Forced engine
+using Forced = lguim::SecureEnumConverter<A, B, struct ForcedTag>;
+
+#define SEC_TYPE Forced
+#define SEC_ENGINE lguim::engine::DenseTable
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) SEC_EQUIV(A::A2, B::B2) SEC_EQUIV(A::A3, B::B3) \
+    SEC_EQUIV(A::A4, B::B4) SEC_EQUIV(A::A5, B::B5) SEC_EQUIV(A::A6, B::B6) \
+    SEC_EQUIV(A::A7, B::B7) SEC_EQUIV(A::A8, B::B8) SEC_EQUIV(A::A9, B::B9)
+#include "lguim/secureenumconverter.inc"
+
+static_assert(
+    EngineReport<Identity>::toExternal().kind == EngineKind::Offset,
+    "Identity is compiled to arithmetic");
+
+START_TEST(EngineReport)
+    // Identity
+    COMPARE_EQ(EngineReport<Identity>::toExternal().kind, EngineKind::Offset);
+    COMPARE_EQ(EngineReport<Identity>::toExternal().entries, 9u);
+    COMPARE_EQ(EngineReport<Identity>::toExternal().tableBytes, 0u);
+    COMPARE_EQ(EngineReport<Identity>::toInternal().kind, EngineKind::Offset);
+
+    // Shuffled
+    COMPARE_EQ(
+        EngineReport<Shuffled>::toExternal().kind, EngineKind::Permutation);
+    COMPARE_EQ(EngineReport<Shuffled>::toExternal().entries, 7u);
+    COMPARE_EQ(EngineReport<Shuffled>::toExternal().tableBytes, 7u);
+    COMPARE_EQ(
+        EngineReport<Shuffled>::toInternal().kind, EngineKind::DenseTable);
+    COMPARE_EQ(EngineReport<Shuffled>::toInternal().entries, 6u);
+    COMPARE_EQ(EngineReport<Shuffled>::toInternal().tableBytes, 9u);
+    COMPARE_EQ(Shuffled::toExternalOpt(A::A7), B::B8);
+    COMPARE_EQ(Shuffled::toExternalOpt(A::A8), std::nullopt);
+    COMPARE_EQ(Shuffled::toInternalOpt(B::B8), A::A6);
+    COMPARE_EQ(Shuffled::toInternalOpt(B::B3), std::nullopt);
+
+    // Sparse
+    COMPARE_EQ(
+        EngineReport<Sparse>::toExternal().kind, EngineKind::Permutation);
+    COMPARE_EQ(EngineReport<Sparse>::toExternal().tableBytes, 36u);
+    COMPARE_EQ(EngineReport<Sparse>::toInternal().kind, EngineKind::SortedKeys);
+    COMPARE_EQ(EngineReport<Sparse>::toInternal().entries, 9u);
+    COMPARE_EQ(EngineReport<Sparse>::toInternal().tableBytes, 45u);
+    COMPARE_EQ(Sparse::toInternalOpt(C::C7), A::A7);
+    COMPARE_EQ(Sparse::toInternalOpt(static_cast<C>(2)), std::nullopt);
+
+    // Small
+    COMPARE_EQ(EngineReport<Small>::toInternal().kind, EngineKind::Switch);
+    COMPARE_EQ(EngineReport<Small>::toInternal().entries, 2u);
+    COMPARE_EQ(Small::toInternalOpt(C::C9), A::A2);
+    COMPARE_EQ(Small::toInternalOpt(C::C5), std::nullopt);
+
+    // Forced
+    COMPARE_EQ(EngineReport<Forced>::toExternal().kind, EngineKind::DenseTable);
+    COMPARE_EQ(EngineReport<Forced>::toInternal().kind, EngineKind::DenseTable);
+    COMPARE_EQ(Forced::toExternalOpt(A::A9), B::B9);
+END_TEST
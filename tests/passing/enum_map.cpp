@@ -0,0 +1,97 @@
+#include <string>
+#include <vector>
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
+
+#include "assertions.h"
+#include "lguim/enummap.h"
+
+enum class A { A1 = 1000, A2 = -3, A3 = 7, A4 = 12 }; struct TA;
+enum class B { B1, B2, B3, B4 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_PROJ_I2E(A::A3, B::B1) \
+    SEC_PROJ_E2I(A::A2, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+using InternalMap = lguim::EnumMap<SUT, lguim::side::Internal, int>;
+using ExternalMap = lguim::EnumMap<SUT, TB, std::string>;
+
+// One entry per value mentioned by the mapping, whatever the gaps.
+static_assert(InternalMap::size() == 4, "A1 to A4");
+static_assert(sizeof(InternalMap) == 4 * sizeof(int), "Flat array");
+static_assert(InternalMap::key(0) == A::A2, "Lowest value first");
+static_assert(InternalMap::ordinal(A::A1) == 3, "Highest value last");
+static_assert(ExternalMap::ordinal(B::B3) == 2, "Contiguous values");
+static_assert(InternalMap::ordinal(static_cast<A>(8)) == 4, "Not mapped");
+
+#if __cplusplus >= 202002L
+static_assert(std::ranges::forward_range<InternalMap>, "Forward range");
+static_assert(std::ranges::forward_range<const InternalMap>, "Forward range");
+#endif
+
+START_TEST(EnumMap)
+    // Value-initialized
+    InternalMap counts;
+    for (auto entry : counts) {
+        COMPARE_EQ(entry.value, 0);
+    }
+
+    // Access
+    ++counts[A::A1];
+    counts[A::A3] += 2;
+    counts.at(A::A4) = 3;
+    COMPARE_EQ(counts[A::A1], 1);
+    COMPARE_EQ(counts[A::A2], 0);
+    COMPARE_EQ(counts.at(A::A3), 2);
+    COMPARE_EQ(counts[A::A4], 3);
+    THROWS(std::out_of_range, counts.at(static_cast<A>(8)));
+    COMPARE_EQ(counts.find(static_cast<A>(8)), nullptr);
+    COMPARE_EQ(counts.find(A::A3), &counts[A::A3]);
+
+    // Iteration by increasing underlying value
+    std::vector<A> keys;
+    std::vector<int> values;
+    for (auto entry : counts) {
+        keys.push_back(entry.key);
+        values.push_back(entry.value);
+    }
+    COMPARE_EQ(keys, (std::vector<A> { A::A2, A::A3, A::A4, A::A1 }));
+    COMPARE_EQ(values, (std::vector<int> { 0, 2, 3, 1 }));
+    COMPARE_EQ(counts.data()[1], 2);
+
+    // Writes through the iteration
+    for (auto entry : counts) {
+        entry.value *= 10;
+    }
+    COMPARE_EQ(counts[A::A4], 30);
+
+    // Comparison and fill
+    InternalMap filled(7);
+    COMPARE_EQ(filled[A::A2], 7);
+    ASSERT(filled != counts);
+    counts.fill(7);
+    ASSERT(filled == counts);
+
+    // Tags and non-trivial values
+    ExternalMap names;
+    names[B::B4] = "B4";
+    COMPARE_EQ(names[B::B4], "B4");
+    COMPARE_EQ(names[B::B1], "");
+    const ExternalMap& constNames = names;
+    COMPARE_EQ(constNames.at(B::B4), "B4");
+    COMPARE_EQ((*constNames.begin()).key, B::B1);
+
+    // Iterators convert to constant iterators
+    ExternalMap::const_iterator it = names.begin();
+    ASSERT(it == constNames.begin());
+    ASSERT(++it != constNames.end());
+    ASSERT(ExternalMap::const_iterator() == ExternalMap::const_iterator());
+END_TEST
@@ -0,0 +1,99 @@
+#include <vector>
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
+
+#include "assertions.h"
+#include "lguim/enumset.h"
+
+enum class A { A1 = 40, A2 = -3, A3 = 7, A4 = 12 }; struct TA;
+enum class B { B1 = 5, B2 = 900, B3 = 1, B4 = 0 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_PROJ_I2E(A::A3, B::B1) \
+    SEC_PROJ_E2I(A::A2, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+using InternalSet = lguim::EnumSet<SUT, lguim::side::Internal>;
+using ExternalSet = lguim::EnumSet<SUT, lguim::side::External>;
+
+// Orphans are part of the domain, values absent from the mapping are not.
+static_assert(InternalSet::Domain::size == 4, "A1 to A4");
+static_assert(ExternalSet::Domain::size == 4, "B1 to B4");
+
+#if __cplusplus >= 202002L
+static_assert(std::ranges::forward_range<InternalSet>, "Forward range");
+#endif
+
+template <typename Set>
+std::vector<typename Set::Value> toVector(const Set& set) {
+    return std::vector<typename Set::Value>(set.begin(), set.end());
+}
+
+// Not mentioned by the mapping.
+constexpr A unknown = static_cast<A>(300);
+
+START_TEST(EnumSet)
+    // Construction and membership
+    InternalSet set { A::A1, A::A3 };
+    ASSERT(set.contains(A::A1));
+    ASSERT(!set.contains(A::A2));
+    ASSERT(set.contains(A::A3));
+    ASSERT(!set.contains(A::A4));
+    ASSERT(!set.contains(unknown));
+    COMPARE_EQ(set.size(), 2u);
+    ASSERT(!set.empty());
+    ASSERT(InternalSet().empty());
+
+    // insert and erase
+    set.insert(A::A4);
+    ASSERT(set.contains(A::A4));
+    THROWS(std::invalid_argument, set.insert(unknown));
+    COMPARE_EQ(set.erase(A::A4), 1u);
+    COMPARE_EQ(set.erase(A::A4), 0u);
+    COMPARE_EQ(set.erase(unknown), 0u);
+
+    // Iteration by increasing underlying value
+    std::vector<A> expectedValues { A::A3, A::A1 };
+    COMPARE_EQ(toVector(set), expectedValues);
+    std::set<A> expectedSet { A::A1, A::A3 };
+    COMPARE_EQ(set.toSet(), expectedSet);
+
+    // all and convertible
+    std::vector<A> allValues { A::A2, A::A3, A::A4, A::A1 };
+    COMPARE_EQ(toVector(InternalSet::all()), allValues);
+    COMPARE_EQ(InternalSet::convertible().toSet(),
+               SUT::convertibleInternalValues());
+    COMPARE_EQ(ExternalSet::convertible().toSet(),
+               SUT::convertibleExternalValues());
+
+    // Set operations
+    InternalSet other { A::A2, A::A3 };
+    COMPARE_EQ(set | other, (InternalSet { A::A1, A::A2, A::A3 }));
+    COMPARE_EQ(set & other, InternalSet { A::A3 });
+    COMPARE_EQ(set - other, InternalSet { A::A1 });
+    COMPARE_EQ(set ^ other, (InternalSet { A::A1, A::A2 }));
+    ASSERT(set != other);
+    set.clear();
+    ASSERT(set.empty());
+
+    // Conversion between sides
+    COMPARE_EQ(InternalSet::all().convert<lguim::side::External>(),
+               (ExternalSet { B::B1, B::B2 }));
+    COMPARE_EQ((InternalSet { A::A2, A::A4 }).convert<lguim::side::External>(),
+               ExternalSet { B::B1 });
+    COMPARE_EQ(ExternalSet::all().convert<lguim::side::Internal>(),
+               (InternalSet { A::A1, A::A2 }));
+
+    // Tags of a TaggedEnumConverter
+    using TaggedSet = lguim::EnumSet<SUT, TB>;
+    TaggedSet tagged { B::B3 };
+    COMPARE_EQ(tagged.convert<TA>().toSet(), std::set<A> { A::A2 });
+    COMPARE_EQ(tagged.convert<lguim::side::Internal>(), InternalSet { A::A2 });
+END_TEST
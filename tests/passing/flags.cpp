@@ -0,0 +1,137 @@
+#include <cstdint>
+
+#include "assertions.h"
+#include "lguim/enumflags.h"
+
+// Bits in another order, a projection, an orphan, and values which are not
+// single bits: per-byte tables.
+enum class Perm : std::uint16_t {
+    None = 0, Read = 1, Write = 2, ReadWrite = 3, Exec = 4, Append = 8,
+    Admin = 0x100, Audit = 0x200,
+};
+enum class WirePerm : std::uint8_t {
+    None = 0, W = 1, R = 2, RW = 3, X = 4, A = 8, Legacy = 16,
+};
+using Perms = lguim::SecureEnumConverter<Perm, WirePerm>;
+
+#define SEC_TYPE Perms
+#define SEC_MAPPING \
+    SEC_EQUIV(Perm::None, WirePerm::None) \
+    SEC_EQUIV(Perm::Read, WirePerm::R) \
+    SEC_EQUIV(Perm::Write, WirePerm::W) \
+    SEC_EQUIV(Perm::ReadWrite, WirePerm::RW) \
+    SEC_EQUIV(Perm::Exec, WirePerm::X) \
+    SEC_PROJ_I2E(Perm::Append, WirePerm::W) \
+    SEC_ORPHAN_INT(Perm::Admin) \
+    SEC_EQUIV(Perm::Audit, WirePerm::A) \
+    SEC_ORPHAN_EXT(WirePerm::Legacy)
+#include "lguim/secureenumconverter.inc"
+
+// Same order, four places higher: a shift
+enum class Low : std::uint8_t { L0 = 1, L1 = 2, L2 = 4, L3 = 8 };
+enum class High : std::uint32_t { H0 = 16, H1 = 32, H2 = 64, H3 = 128 };
+using Shifted = lguim::SecureEnumConverter<Low, High>;
+
+#define SEC_TYPE Shifted
+#define SEC_MAPPING \
+    SEC_EQUIV(Low::L0, High::H0) \
+    SEC_EQUIV(Low::L1, High::H1) \
+    SEC_EQUIV(Low::L2, High::H2) \
+    SEC_EQUIV(Low::L3, High::H3)
+#include "lguim/secureenumconverter.inc"
+
+// Same order, spread out: `pext` and `pdep`
+enum class Near : std::uint32_t { N0 = 1, N1 = 2, N2 = 4, N3 = 0x10000 };
+enum class Far : std::uint64_t {
+    F0 = 2, F1 = 0x20, F2 = 0x200, F3 = 0x100000000,
+};
+using Spread = lguim::SecureEnumConverter<Near, Far>;
+
+#define SEC_TYPE Spread
+#define SEC_MAPPING \
+    SEC_EQUIV(Near::N0, Far::F0) \
+    SEC_EQUIV(Near::N1, Far::F1) \
+    SEC_EQUIV(Near::N2, Far::F2) \
+    SEC_EQUIV(Near::N3, Far::F3)
+#include "lguim/secureenumconverter.inc"
+
+template <typename Enum>
+Enum flags(unsigned long long bits) { return static_cast<Enum>(bits); }
+
+START_TEST(Flags)
+    using lguim::side::External;
+    using lguim::side::Internal;
+
+    auto toWire = [](unsigned bits) {
+        return lguim::convertFlags<Perms, External>(flags<Perm>(bits));
+    };
+
+    // Many-to-one and reordered bits
+    const auto readAppend = toWire(0x1 | 0x8);
+    COMPARE_EQ(readAppend.flags, flags<WirePerm>(0x2 | 0x1));
+    COMPARE_EQ(readAppend.unmapped, 0u);
+    ASSERT(readAppend.ok());
+
+    // Orphan and unknown bits are reported, the others still convert
+    const auto withAdmin = toWire(0x2 | 0x4 | 0x100 | 0x400 | 0x200);
+    COMPARE_EQ(withAdmin.flags, flags<WirePerm>(0x1 | 0x4 | 0x8));
+    COMPARE_EQ(withAdmin.unmapped, 0x500u);
+    ASSERT(!withAdmin.ok());
+
+    COMPARE_EQ(toWire(0).flags, WirePerm::None);
+    COMPARE_EQ(toWire(0).unmapped, 0u);
+    COMPARE_EQ(toWire(0xffff).flags, flags<WirePerm>(0xf));
+    COMPARE_EQ(toWire(0xffff).unmapped, 0xfdf0u);
+
+    // Other direction: the projection does not convert back
+    const auto fromWire = lguim::convertFlags<Perms, Internal>(
+        flags<WirePerm>(0x1 | 0x2 | 0x8 | 0x10));
+    COMPARE_EQ(fromWire.flags, flags<Perm>(0x2 | 0x1 | 0x200));
+    COMPARE_EQ(fromWire.unmapped, 0x10u);
+
+    // Shift
+    const auto shifted = lguim::convertFlags<Shifted, External>(
+        flags<Low>(0x5 | 0x40));
+    COMPARE_EQ(shifted.flags, flags<High>(0x50));
+    COMPARE_EQ(shifted.unmapped, 0x40u);
+    const auto unshifted = lguim::convertFlags<Shifted, Internal>(
+        flags<High>(0x80 | 0x1));
+    COMPARE_EQ(unshifted.flags, Low::L3);
+    COMPARE_EQ(unshifted.unmapped, 0x1u);
+
+    // Gather and scatter
+    const auto spread = lguim::convertFlags<Spread, External>(
+        flags<Near>(0x10000 | 0x2 | 0x8));
+    COMPARE_EQ(spread.flags, flags<Far>(0x100000000 | 0x20));
+    COMPARE_EQ(spread.unmapped, 0x8u);
+    const auto gathered = lguim::convertFlags<Spread, Internal>(
+        flags<Far>(0x200 | 0x2 | 0x4));
+    COMPARE_EQ(gathered.flags, flags<Near>(0x4 | 0x1));
+    COMPARE_EQ(gathered.unmapped, 0x4u);
+
+    // Kernels of the gathering mapping, against the tables
+    using Source = lguim::priv::FlagSource<Spread, lguim::side::External>;
+    using Kernels = lguim::priv::FlagKernels<Source>;
+
+    ASSERT(!lguim::priv::FlagLayout<Source>::shifts());
+    ASSERT(lguim::priv::FlagBits<Source>::ordered());
+    ASSERT(!lguim::priv::FlagBits<
+        lguim::priv::FlagSource<Perms, lguim::side::External>>::ordered());
+    ASSERT(lguim::priv::FlagLayout<
+        lguim::priv::FlagSource<Shifted, lguim::side::Internal>>::shifts());
+    COMPARE_EQ(lguim::priv::FlagLayout<Source>::byteCount, 3u);
+
+    bool same = true;
+    for (std::uint32_t low = 0; low < 16; ++low) {
+        for (std::uint32_t high = 0; high < 4; ++high) {
+            const std::uint32_t bits = low | high << 15;
+            same = same && Kernels::table(bits) == Kernels::convert(bits);
+#if LGUIM_SEC_SIMD_X86
+            if (__builtin_cpu_supports("bmi2")) {
+                same = same && Kernels::table(bits) == Kernels::pext(bits);
+            }
+#endif
+        }
+    }
+    ASSERT(same);
+END_TEST
@@ -0,0 +1,183 @@
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+// Signed and small: a table covering [-100, 120]
+enum class A : std::uint8_t { A1, A2, A3, A4, A5 };
+enum class W : std::int8_t {
+    W1 = -100, W2 = -3, W3 = 0, W4 = 7, W5 = 120, W6 = 50,
+};
+using SUT = lguim::SecureEnumConverter<A, W>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, W::W1) \
+    SEC_EQUIV(A::A2, W::W2) \
+    SEC_EQUIV(A::A3, W::W3) \
+    SEC_PROJ_E2I(A::A3, W::W6) \
+    SEC_EQUIV(A::A4, W::W4) \
+    SEC_ORPHAN_INT(A::A5) \
+    SEC_ORPHAN_EXT(W::W5)
+#include "lguim/secureenumconverter.inc"
+
+// Sparse: a binary search
+enum class S : std::int32_t { S1 = -5000000, S2 = 0, S3 = 1000000 };
+using Sparse = lguim::SecureEnumConverter<A, S>;
+
+#define SEC_TYPE Sparse
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, S::S1) \
+    SEC_EQUIV(A::A2, S::S2) \
+    SEC_EQUIV(A::A3, S::S3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_INT(A::A5)
+#include "lguim/secureenumconverter.inc"
+
+// Consecutive values: an offset
+enum class C : std::uint16_t { C1 = 100, C2, C3, C4, C5 };
+using Offset = lguim::SecureEnumConverter<A, C>;
+
+#define SEC_TYPE Offset
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, C::C1) \
+    SEC_EQUIV(A::A2, C::C2) \
+    SEC_EQUIV(A::A3, C::C3) \
+    SEC_EQUIV(A::A4, C::C4) \
+    SEC_EQUIV(A::A5, C::C5)
+#include "lguim/secureenumconverter.inc"
+
+// Without the rows: through the conversion of the enumeration
+using NoRows = lguim::SecureEnumConverter<A, W, struct NoRowsTag>;
+
+#define SEC_TYPE NoRows
+#define SEC_NO_SWITCH_EXTERNAL
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, W::W1) \
+    SEC_EQUIV(A::A2, W::W2) \
+    SEC_EQUIV(A::A3, W::W3) \
+    SEC_PROJ_E2I(A::A3, W::W6) \
+    SEC_EQUIV(A::A4, W::W4) \
+    SEC_ORPHAN_INT(A::A5) \
+    SEC_ORPHAN_EXT(W::W5)
+#include "lguim/secureenumconverter.inc"
+
+template <typename Converter>
+using Lookup = lguim::priv::ProbeLookup<
+    typename lguim::priv::UnderlyingLookup<Converter>::Source>;
+
+static_assert(std::is_same<
+        Lookup<SUT>,
+        lguim::priv::ProbeTable<typename lguim::priv::UnderlyingLookup<
+            SUT>::Source>>::value,
+    "Small range: table");
+static_assert(std::is_same<
+        Lookup<Sparse>,
+        lguim::priv::SortedTable<typename lguim::priv::UnderlyingLookup<
+            Sparse>::Source>>::value,
+    "Sparse: binary search");
+static_assert(std::is_same<
+        Lookup<Offset>,
+        lguim::priv::OffsetLookup<typename lguim::priv::UnderlyingLookup<
+            Offset>::Source>>::value,
+    "Consecutive: offset");
+
+START_TEST(FromUnderlying)
+    // Every value of the underlying type, against the conversion of the
+    // enumeration
+    bool same = true;
+    for (int raw = -128; raw < 128; ++raw) {
+        const auto expected = SUT::toInternalOpt(static_cast<W>(raw));
+        same = same
+            && SUT::fromUnderlying(static_cast<std::int8_t>(raw)) == expected
+            && SUT::fromUnderlying(raw) == expected
+            && NoRows::fromUnderlying(raw) == expected;
+    }
+    ASSERT(same);
+
+    COMPARE_EQ(SUT::fromUnderlying(-100), A::A1);
+    COMPARE_EQ(SUT::fromUnderlying(std::int8_t{50}), A::A3);
+    COMPARE_EQ(SUT::fromUnderlying(7u), A::A4);
+    COMPARE_EQ(SUT::fromUnderlying(std::uint64_t{7}), A::A4);
+    COMPARE_EQ(SUT::fromUnderlying(-3LL), A::A2);
+
+    // Orphans and values between the enumerators
+    COMPARE_EQ(SUT::fromUnderlying(120), std::nullopt);
+    COMPARE_EQ(SUT::fromUnderlying(1), std::nullopt);
+    COMPARE_EQ(SUT::fromUnderlying(-128), std::nullopt);
+
+    // Out of the range of the underlying type: not truncated
+    COMPARE_EQ(SUT::fromUnderlying(7 + 256), std::nullopt);
+    COMPARE_EQ(SUT::fromUnderlying(-100 - 256), std::nullopt);
+    COMPARE_EQ(SUT::fromUnderlying(std::uint8_t{0x9c}), std::nullopt);
+    COMPARE_EQ(
+        SUT::fromUnderlying(std::numeric_limits<std::uint64_t>::max()),
+        std::nullopt);
+    COMPARE_EQ(
+        SUT::fromUnderlying(std::numeric_limits<std::int64_t>::min()),
+        std::nullopt);
+    COMPARE_EQ(NoRows::fromUnderlying(7 + 256), std::nullopt);
+
+    // Sparse
+    COMPARE_EQ(Sparse::fromUnderlying(-5000000), A::A1);
+    COMPARE_EQ(Sparse::fromUnderlying(1000000L), A::A3);
+    COMPARE_EQ(Sparse::fromUnderlying(1), std::nullopt);
+    COMPARE_EQ(Sparse::fromUnderlying(std::int64_t{1} << 32), std::nullopt);
+    COMPARE_EQ(Sparse::fromUnderlying(0xffffffffu), std::nullopt);
+
+    // Negative values of an unsigned underlying type
+    COMPARE_EQ(Offset::fromUnderlying(102), A::A3);
+    COMPARE_EQ(Offset::fromUnderlying(99), std::nullopt);
+    COMPARE_EQ(Offset::fromUnderlying(105), std::nullopt);
+    COMPARE_EQ(Offset::fromUnderlying(-1), std::nullopt);
+    COMPARE_EQ(Offset::fromUnderlying(65536 + 100), std::nullopt);
+    COMPARE_EQ(Offset::fromUnderlying(-65536 + 100), std::nullopt);
+
+    // Batch: invalid outputs are left untouched
+    const std::int8_t raw[] = { -100, 1, 50, 120, 7, -3 };
+    A output[6] = { A::A5, A::A5, A::A5, A::A5, A::A5, A::A5 };
+    const lguim::BatchResult result = SUT::fromUnderlyingBatch(raw, 6, output);
+    COMPARE_EQ(result.invalidCount, 2u);
+    COMPARE_EQ(result.firstInvalid, 1u);
+    COMPARE_EQ(output[0], A::A1);
+    COMPARE_EQ(output[1], A::A5);
+    COMPARE_EQ(output[2], A::A3);
+    COMPARE_EQ(output[3], A::A5);
+    COMPARE_EQ(output[4], A::A4);
+    COMPARE_EQ(output[5], A::A2);
+
+    A noRowsOutput[6] = { A::A5, A::A5, A::A5, A::A5, A::A5, A::A5 };
+    const lguim::BatchResult noRowsResult =
+        NoRows::fromUnderlyingBatch(raw, 6, noRowsOutput);
+    COMPARE_EQ(noRowsResult.invalidCount, 2u);
+    COMPARE_EQ(noRowsResult.firstInvalid, 1u);
+    COMPARE_EQ(noRowsOutput[2], A::A3);
+    COMPARE_EQ(noRowsOutput[3], A::A5);
+
+    const lguim::BatchResult valid = SUT::fromUnderlyingBatch(raw, 1, output);
+    ASSERT(valid.ok());
+    COMPARE_EQ(valid.firstInvalid, 1u);
+
+    // Validity bits, from the kernels then the lookup of the last values
+    std::int8_t many[75];
+    for (std::size_t i = 0; i < 75; ++i) {
+        many[i] = raw[i % 6];
+    }
+    std::uint8_t validity[10];
+    std::uint8_t noRowsValidity[10];
+    A manyOutput[75] = {};
+    const lguim::BatchResult manyResult =
+        SUT::fromUnderlyingBatch(many, 75, manyOutput, validity);
+    NoRows::fromUnderlyingBatch(many, 75, manyOutput, noRowsValidity);
+    COMPARE_EQ(manyResult.invalidCount, 25u);
+    COMPARE_EQ(manyResult.firstInvalid, 1u);
+    // Values 1 and 3 of each 6 are invalid
+    COMPARE_EQ(validity[0], 0x75u);
+    COMPARE_EQ(validity[8], 0xd7u);
+    COMPARE_EQ(validity[9], 0x05u);
+    for (std::size_t i = 0; i < 10; ++i) {
+        COMPARE_EQ(noRowsValidity[i], validity[i]);
+    }
+END_TEST
@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/enumhistogram.h"
+
+enum class A : std::uint8_t { A1, A2, A2_old, A3, A4 }; struct TA;
+enum class B : std::int32_t { B1 = 3000, B2 = -200, B3 = 10, B4 = 4 };
+struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) \
+    SEC_EQUIV(A::A2, B::B2) \
+    SEC_PROJ_I2E(A::A2_old, B::B2) \
+    SEC_EQUIV(A::A3, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+struct Record {
+    std::uint32_t id;
+    A status;
+};
+
+START_TEST(Histogram)
+    // Compared to counting the conversions in a map, on every input size
+    // around the unrolling
+    bool sameCounts = true;
+    for (std::size_t size = 0; size < 40; ++size) {
+        std::vector<A> internal;
+        std::map<B, std::size_t> expected;
+        std::size_t expectedInvalid = 0;
+
+        for (std::size_t i = 0; i < size; ++i) {
+            internal.push_back(static_cast<A>((i * 7 + size) % 5));
+            const auto converted = SUT::convertOpt<TB>(internal.back());
+            if (converted) {
+                ++expected[*converted];
+            } else {
+                ++expectedInvalid;
+            }
+        }
+
+        const auto histogram = lguim::conversionHistogram<SUT, TB>(
+            internal.data(), internal.size());
+        sameCounts = sameCounts && histogram.invalidCount == expectedInvalid;
+        for (B b : { B::B1, B::B2, B::B3, B::B4 }) {
+            sameCounts = sameCounts && histogram.counts[b] == expected[b];
+        }
+    }
+    ASSERT(sameCounts);
+
+    // Other direction
+    const std::vector<B> external { B::B4, B::B3, B::B3, B::B2, B::B1 };
+    const auto internalHistogram =
+        lguim::conversionHistogram<SUT, lguim::side::Internal>(
+            external.data(), external.size());
+    COMPARE_EQ(internalHistogram.counts[A::A1], 1u);
+    COMPARE_EQ(internalHistogram.counts[A::A2], 1u);
+    COMPARE_EQ(internalHistogram.counts[A::A2_old], 0u);
+    COMPARE_EQ(internalHistogram.counts[A::A3], 2u);
+    COMPARE_EQ(internalHistogram.counts[A::A4], 0u);
+    COMPARE_EQ(internalHistogram.invalidCount, 1u);
+
+    // Partition of records, by increasing external value
+    const std::vector<Record> records {
+        { 10, A::A1 }, { 11, A::A2 }, { 12, A::A4 }, { 13, A::A2_old },
+        { 14, A::A3 }, { 15, A::A1 }, { 16, A::A4 }, { 17, A::A2 },
+    };
+
+    const auto histogram = lguim::conversionHistogram<SUT, TB>(
+        &records[0].status, sizeof(Record), records.size());
+    COMPARE_EQ(histogram.counts[B::B2], 3u);
+    COMPARE_EQ(histogram.invalidCount, 2u);
+
+    std::vector<std::size_t> indexes(records.size());
+    const auto partition = lguim::partitionByConversion<SUT, TB>(
+        &records[0].status, sizeof(Record), records.size(), indexes.data());
+    ASSERT(indexes == std::vector<std::size_t> { 1, 3, 7, 4, 0, 5, 2, 6 });
+    COMPARE_EQ(partition.begin(B::B2), 0u);
+    COMPARE_EQ(partition.end(B::B2), 3u);
+    COMPARE_EQ(partition.begin(B::B4), 3u);
+    COMPARE_EQ(partition.count(B::B4), 0u);
+    COMPARE_EQ(partition.begin(B::B3), 3u);
+    COMPARE_EQ(partition.count(B::B3), 1u);
+    COMPARE_EQ(partition.begin(B::B1), 4u);
+    COMPARE_EQ(partition.count(B::B1), 2u);
+    COMPARE_EQ(partition.invalidBegin(), 6u);
+    COMPARE_EQ(partition.invalidCount(), 2u);
+
+    // Contiguous values
+    const std::vector<A> internal { A::A3, A::A4, A::A3 };
+    indexes.resize(internal.size());
+    const auto contiguous = lguim::partitionByConversion<SUT, TB>(
+        internal.data(), internal.size(), indexes.data());
+    ASSERT(indexes == std::vector<std::size_t> { 0, 2, 1 });
+    COMPARE_EQ(contiguous.count(B::B3), 2u);
+    COMPARE_EQ(contiguous.invalidCount(), 1u);
+END_TEST
@@ -0,0 +1,41 @@
+#include <string>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+// An inline mapping comparing strings: std::string is not a literal type,
+// so the conversions must not be constexpr.
+enum class A { A1, A2, A3 };
+using SUT = lguim::SecureEnumConverter<A, std::string>;
+
+#define SEC_TYPE SUT
+#define SEC_INLINE
+#define SEC_NO_SWITCH_EXTERNAL
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, "A1") \
+    SEC_PROJ_E2I(A::A2, "A2_old") \
+    SEC_EQUIV(A::A2, "A2") \
+    SEC_ORPHAN_INT(A::A3) \
+    SEC_ORPHAN_EXT("A3")
+#include "lguim/secureenumconverter.inc"
+
+START_TEST(InlineNoSwitch)
+    // toExternalOpt
+    COMPARE_EQ(SUT::toExternalOpt(A::A1), "A1");
+    COMPARE_EQ(SUT::toExternalOpt(A::A2), "A2");
+    COMPARE_EQ(SUT::toExternalOpt(A::A3), std::nullopt);
+
+    // toInternalOpt
+    COMPARE_EQ(SUT::toInternalOpt("A1"), A::A1);
+    COMPARE_EQ(SUT::toInternalOpt("A2_old"), A::A2);
+    COMPARE_EQ(SUT::toInternalOpt("A3"), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt("A4"), std::nullopt);
+
+    // isConvertibleExternal
+    ASSERT(SUT::isConvertibleExternal("A2"));
+    ASSERT(!SUT::isConvertibleExternal("A3"));
+
+    // convertibleExternalSpan
+    const std::set<std::string> expectedExternalValues { "A1", "A2", "A2_old" };
+    COMPARE_EQ(SUT::convertibleExternalSpan().toSet(), expectedExternalValues);
+END_TEST
@@ -0,0 +1,51 @@
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A { A1, A2, A3 };
+enum class B { B1, B2, B3 };
+using SUT = lguim::SecureEnumConverter<A, B>;
+
+#define SEC_TYPE SUT
+#define SEC_INLINE
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) \
+    SEC_EQUIV(A::A2, B::B2) \
+    SEC_ORPHAN_INT(A::A3) \
+    SEC_ORPHAN_EXT(B::B3)
+#include "lguim/secureenumconverter.inc"
+
+// Conversions are usable in constant expressions.
+static_assert(*SUT::toExternalOpt(A::A1) == B::B1, "A1 → B1");
+static_assert(*SUT::toInternalOpt(B::B2) == A::A2, "B2 → A2");
+static_assert(!SUT::toExternalOpt(A::A3), "A3 is an orphan");
+static_assert(!SUT::toInternalOpt(B::B3), "B3 is an orphan");
+
+START_TEST(Inline)
+    // toExternalOpt
+    COMPARE_EQ(SUT::toExternalOpt(A::A1), B::B1);
+    COMPARE_EQ(SUT::toExternalOpt(A::A2), B::B2);
+    COMPARE_EQ(SUT::toExternalOpt(A::A3), std::nullopt);
+
+    // toInternalOpt
+    COMPARE_EQ(SUT::toInternalOpt(B::B1), A::A1);
+    COMPARE_EQ(SUT::toInternalOpt(B::B2), A::A2);
+    COMPARE_EQ(SUT::toInternalOpt(B::B3), std::nullopt);
+
+    // toExternalOrThrow
+    COMPARE_EQ(SUT::toExternalOrThrow(A::A1), B::B1);
+    COMPARE_EQ(SUT::toExternalOrThrow(A::A2), B::B2);
+    THROWS(std::invalid_argument, SUT::toExternalOrThrow(A::A3));
+
+    // toInternalOrThrow
+    COMPARE_EQ(SUT::toInternalOrThrow(B::B1), A::A1);
+    COMPARE_EQ(SUT::toInternalOrThrow(B::B2), A::A2);
+    THROWS(std::invalid_argument, SUT::toInternalOrThrow(B::B3));
+
+    // convertibleInternalValues
+    std::set<A> expectedInternalValues { A::A1, A::A2 };
+    COMPARE_EQ(SUT::convertibleInternalValues(), expectedInternalValues);
+
+    // convertibleInternalValues
+    std::set<B> expectedExternalValues { B::B1, B::B2 };
+    COMPARE_EQ(SUT::convertibleExternalValues(), expectedExternalValues);
+END_TEST
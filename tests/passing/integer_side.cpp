@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <set>
+#include <type_traits>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+// An integer side: no mapping rows, the sets of values are used instead
+enum class A { A1, A2, A3 };
+using SUT = lguim::SecureEnumConverter<A, int>;
+
+#define SEC_TYPE SUT
+#define SEC_ENGINE lguim::engine::Switch
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, 10) \
+    SEC_EQUIV(A::A2, 20) \
+    SEC_PROJ_E2I(A::A2, 25) \
+    SEC_ORPHAN_INT(A::A3)
+#include "lguim/secureenumconverter.inc"
+
+// Same, with the default engine
+using Defaulted = lguim::SecureEnumConverter<A, std::int16_t>;
+
+#define SEC_TYPE Defaulted
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, -1) \
+    SEC_EQUIV(A::A2, 1) \
+    SEC_ORPHAN_INT(A::A3)
+#include "lguim/secureenumconverter.inc"
+
+static_assert(std::is_same<
+        lguim::priv::DefaultEngine<Defaulted>, lguim::engine::Switch>::value,
+    "Integer side: Switch by default");
+
+START_TEST(IntegerSide)
+    // Single values
+    COMPARE_EQ(SUT::toExternalOpt(A::A1), 10);
+    COMPARE_EQ(SUT::toExternalOpt(A::A3), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(25), A::A2);
+    COMPARE_EQ(SUT::toInternalOpt(11), std::nullopt);
+    ASSERT(SUT::isConvertibleInternal(A::A2));
+    ASSERT(!SUT::isConvertibleInternal(A::A3));
+    ASSERT(SUT::isConvertibleExternal(20));
+    ASSERT(!SUT::isConvertibleExternal(0));
+
+    // Batches
+    const int external[] = { 10, 25, 11, 20 };
+    A internal[4] = { A::A3, A::A3, A::A3, A::A3 };
+    const lguim::BatchResult result =
+        SUT::toInternalBatch(external, 4, internal);
+    COMPARE_EQ(result.invalidCount, 1u);
+    COMPARE_EQ(result.firstInvalid, 2u);
+    COMPARE_EQ(internal[1], A::A2);
+    COMPARE_EQ(internal[2], A::A3);
+    COMPARE_EQ(SUT::firstInvalidExternal(external, 4), 2u);
+    COMPARE_EQ(SUT::firstInvalidInternal(internal, 4), 2u);
+
+    // Underlying values
+    COMPARE_EQ(SUT::fromUnderlying(25), A::A2);
+    COMPARE_EQ(SUT::fromUnderlying(std::int64_t{1} << 40), std::nullopt);
+    A fromRaw[4] = { A::A3, A::A3, A::A3, A::A3 };
+    COMPARE_EQ(SUT::fromUnderlyingBatch(external, 4, fromRaw).invalidCount, 1u);
+    COMPARE_EQ(fromRaw[3], A::A2);
+
+    // Spans, copied from the sets
+    const std::set<int> expectedExternal { 10, 20, 25 };
+    COMPARE_EQ(SUT::convertibleExternalSpan().toSet(), expectedExternal);
+    COMPARE_EQ(SUT::convertibleInternalSpan().size(), 2u);
+    ASSERT(SUT::convertibleInternalSpan().contains(A::A2));
+
+    // Default engine
+    COMPARE_EQ(Defaulted::toExternalOpt(A::A1), std::int16_t{-1});
+    COMPARE_EQ(Defaulted::toInternalOpt(std::int16_t{1}), A::A2);
+    COMPARE_EQ(Defaulted::fromUnderlying(-1), A::A1);
+    COMPARE_EQ(Defaulted::fromUnderlying(70000), std::nullopt);
+    const std::int16_t codes[] = { 1, 0, -1 };
+    A fromCodes[3] = { A::A3, A::A3, A::A3 };
+    const lguim::BatchResult codesResult =
+        Defaulted::toInternalBatch(codes, 3, fromCodes);
+    COMPARE_EQ(codesResult.invalidCount, 1u);
+    COMPARE_EQ(codesResult.firstInvalid, 1u);
+    COMPARE_EQ(fromCodes[2], A::A1);
+    ASSERT(!Defaulted::isConvertibleExternal(0));
+    COMPARE_EQ(Defaulted::convertibleExternalSpan().size(), 2u);
+END_TEST
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 
 #include "assertions.h"
 #include "lguim/secureenumconverter.h"
@@ -39,4 +40,28 @@ START_TEST(NoSwitchExternal)
     // convertibleInternalValues
     std::set<std::string> expectedExternalValues { "A1", "A2" };
     COMPARE_EQ(SUT::convertibleExternalValues(), expectedExternalValues);
+
+    // convertibleExternalSpan
+    COMPARE_EQ(SUT::convertibleExternalSpan().size(), 2u);
+    COMPARE_EQ(SUT::convertibleExternalSpan().toSet(), expectedExternalValues);
+    ASSERT(SUT::convertibleExternalSpan().contains("A2"));
+    ASSERT(!SUT::convertibleExternalSpan().contains("A3"));
+
+    // toExternalStrided, toInternalStrided
+    struct Record { A internal; std::string external; };
+    std::vector<Record> records { { A::A2, "" }, { A::A1, "A3" } };
+    ASSERT(SUT::toExternalStrided(
+        &records[0].internal, sizeof(Record), records.size(),
+        &records[0].external, sizeof(Record)).ok());
+    COMPARE_EQ(records[0].external, "A2");
+    COMPARE_EQ(records[1].external, "A1");
+
+    records[0].external = "A3";
+    const lguim::BatchResult result = SUT::toInternalStrided(
+        &records[0].external, sizeof(Record), records.size(),
+        &records[0].internal, sizeof(Record));
+    COMPARE_EQ(result.invalidCount, 1u);
+    COMPARE_EQ(result.firstInvalid, 0u);
+    COMPARE_EQ(records[0].internal, A::A2);
+    COMPARE_EQ(records[1].internal, A::A1);
 END_TEST
@@ -0,0 +1,57 @@
+#include <cstdint>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A : std::int8_t { A0 = -3, A1, A2, A3, A4 = 100 };
+enum class B : std::uint16_t { B0 = 7, B1, B2, B3, B5 = 3 };
+using SUT = lguim::SecureEnumConverter<A, B>;
+
+#define SEC_TYPE SUT
+#define SEC_ENGINE lguim::engine::Offset
+#define SEC_MAPPING             \
+    SEC_EQUIV(A::A0, B::B0)     \
+    SEC_EQUIV(A::A1, B::B1)     \
+    SEC_EQUIV(A::A2, B::B2)     \
+    SEC_EQUIV(A::A3, B::B3)     \
+    SEC_ORPHAN_INT(A::A4)       \
+    SEC_ORPHAN_EXT(B::B5)
+#include "lguim/secureenumconverter.inc"
+
+START_TEST(Offset)
+    // toExternalOpt
+    COMPARE_EQ(SUT::toExternalOpt(A::A0), B::B0);
+    COMPARE_EQ(SUT::toExternalOpt(A::A1), B::B1);
+    COMPARE_EQ(SUT::toExternalOpt(A::A2), B::B2);
+    COMPARE_EQ(SUT::toExternalOpt(A::A3), B::B3);
+    COMPARE_EQ(SUT::toExternalOpt(A::A4), std::nullopt);
+    COMPARE_EQ(SUT::toExternalOpt(static_cast<A>(-4)), std::nullopt);
+    COMPARE_EQ(SUT::toExternalOpt(static_cast<A>(1)), std::nullopt);
+    COMPARE_EQ(SUT::toExternalOpt(static_cast<A>(-128)), std::nullopt);
+
+    // toInternalOpt
+    COMPARE_EQ(SUT::toInternalOpt(B::B0), A::A0);
+    COMPARE_EQ(SUT::toInternalOpt(B::B1), A::A1);
+    COMPARE_EQ(SUT::toInternalOpt(B::B2), A::A2);
+    COMPARE_EQ(SUT::toInternalOpt(B::B3), A::A3);
+    COMPARE_EQ(SUT::toInternalOpt(B::B5), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(6)), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(11)), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(65535)), std::nullopt);
+
+    // toExternalOrThrow
+    COMPARE_EQ(SUT::toExternalOrThrow(A::A0), B::B0);
+    THROWS(std::invalid_argument, SUT::toExternalOrThrow(A::A4));
+
+    // toInternalOrThrow
+    COMPARE_EQ(SUT::toInternalOrThrow(B::B3), A::A3);
+    THROWS(std::invalid_argument, SUT::toInternalOrThrow(B::B5));
+
+    // convertibleInternalValues
+    std::set<A> expectedInternalValues { A::A0, A::A1, A::A2, A::A3 };
+    COMPARE_EQ(SUT::convertibleInternalValues(), expectedInternalValues);
+
+    // convertibleInternalValues
+    std::set<B> expectedExternalValues { B::B0, B::B1, B::B2, B::B3 };
+    COMPARE_EQ(SUT::convertibleExternalValues(), expectedExternalValues);
+END_TEST
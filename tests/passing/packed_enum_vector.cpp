@@ -0,0 +1,94 @@
+#include <iterator>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/packedenumvector.h"
+
+enum class A { A1 = 1000, A2 = -3, A3 = 7, A4 = 12, A5 = 13 }; struct TA;
+enum class B { B1, B2, B3 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_PROJ_I2E(A::A3, B::B1) \
+    SEC_EQUIV(A::A4, B::B3) \
+    SEC_ORPHAN_INT(A::A5)
+#include "lguim/secureenumconverter.inc"
+
+using InternalVector = lguim::PackedEnumVector<SUT, lguim::side::Internal>;
+using ExternalVector = lguim::PackedEnumVector<SUT, TB>;
+
+static_assert(InternalVector::bitsPerValue == 3, "5 values");
+static_assert(ExternalVector::bitsPerValue == 2, "3 values");
+
+#if __cplusplus >= 202002L
+static_assert(
+    std::random_access_iterator<InternalVector::const_iterator>,
+    "Random access iterators");
+#endif
+
+START_TEST(PackedEnumVector)
+    // push_back and random access, across word boundaries
+    const std::vector<A> pattern { A::A1, A::A2, A::A3, A::A4, A::A2 };
+    std::vector<A> values;
+    InternalVector vector;
+    for (std::size_t i = 0; i < 100; ++i) {
+        values.push_back(pattern[i % pattern.size()]);
+        vector.push_back(values.back());
+    }
+    COMPARE_EQ(vector.size(), 100u);
+    COMPARE_EQ(vector.storageBytes(), 40u);
+    COMPARE_EQ(std::vector<A>(vector.begin(), vector.end()), values);
+    COMPARE_EQ(vector[21], values[21]);
+
+    // Random access iterators
+    ASSERT(2 + vector.begin() == vector.begin() + 2);
+    COMPARE_EQ(*(21 + vector.begin()), values[21]);
+    ASSERT(vector.end() > vector.begin());
+    ASSERT(vector.begin() <= vector.begin());
+    ASSERT(vector.end() >= vector.begin() + 100);
+    ASSERT(!(vector.begin() >= vector.end()));
+    COMPARE_EQ(vector.at(99), values[99]);
+    THROWS(std::out_of_range, vector.at(100));
+    THROWS(std::invalid_argument, vector.push_back(static_cast<A>(8)));
+    COMPARE_EQ(vector.size(), 100u);
+
+    // set
+    vector.set(21, A::A5);
+    COMPARE_EQ(vector[20], values[20]);
+    COMPARE_EQ(vector[21], A::A5);
+    COMPARE_EQ(vector[22], values[22]);
+    vector.set(21, values[21]);
+
+    // Bulk pack and unpack
+    InternalVector packed;
+    packed.pack(values.data(), values.size());
+    ASSERT(packed == vector);
+    std::vector<A> unpacked(10);
+    packed.unpack(40, 10, unpacked.data());
+    COMPARE_EQ(unpacked, std::vector<A>(values.begin() + 40,
+                                        values.begin() + 50));
+
+    // A failed pack adds nothing
+    const A invalid[] { A::A1, static_cast<A>(8) };
+    THROWS(std::invalid_argument, packed.pack(invalid, 2));
+    ASSERT(packed == vector);
+
+    // Conversion without unpacking
+    ExternalVector converted = vector.convert<TB>();
+    COMPARE_EQ(converted.size(), 100u);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        COMPARE_EQ(converted[i], SUT::toExternalOrThrow(values[i]));
+    }
+    COMPARE_EQ(converted.storageBytes(), 32u);
+
+    InternalVector orphans(3, A::A5);
+    COMPARE_EQ(orphans[2], A::A5);
+    THROWS(std::invalid_argument, orphans.convert<TB>());
+
+    // Back to the internal side
+    ExternalVector external(4, B::B3);
+    COMPARE_EQ(external.convert<lguim::side::Internal>()[3], A::A4);
+END_TEST
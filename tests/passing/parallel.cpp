@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/parallelconversion.h"
+
+enum class A : std::uint16_t { A1, A2, A3, A4 }; struct TA;
+enum class B : std::int32_t { B1 = 10, B2 = 200, B3 = 3000, B4 = 4 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_EQUIV(A::A3, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+START_TEST(Parallel)
+    std::vector<A> internal;
+    for (std::size_t i = 0; i < 100000; ++i) {
+        internal.push_back(static_cast<A>(i % 3));
+    }
+    internal[31337] = A::A4;
+    internal[31338] = A::A4;
+    internal[99999] = A::A4;
+
+    std::vector<B> expected(internal.size(), B::B4);
+    const lguim::BatchResult single = SUT::toExternalBatch(
+        internal.data(), internal.size(), expected.data());
+    COMPARE_EQ(single.invalidCount, 3u);
+    COMPARE_EQ(single.firstInvalid, 31337u);
+
+    // Same result whatever the threads and chunks
+    const std::size_t threads[] = { 0, 1, 2, 3, 8 };
+    const std::size_t chunks[] = { 0, 1, 7, 31337, 1000000 };
+    bool sameResults = true;
+    bool sameOutputs = true;
+
+    for (std::size_t threadCount : threads) {
+        for (std::size_t chunkSize : chunks) {
+            std::vector<B> external(internal.size(), B::B4);
+            const lguim::BatchResult result = lguim::parallelConvertBatch<
+                SUT, lguim::side::External>(
+                    internal.data(), internal.size(), external.data(),
+                    lguim::ParallelOptions(threadCount, chunkSize));
+
+            sameResults = sameResults
+                && result.invalidCount == single.invalidCount
+                && result.firstInvalid == single.firstInvalid;
+            sameOutputs = sameOutputs && external == expected;
+        }
+    }
+
+    ASSERT(sameResults);
+    ASSERT(sameOutputs);
+
+    // Tags, and the other direction
+    std::vector<A> back(expected.size());
+    lguim::BatchResult result = lguim::parallelConvertBatch<SUT, TA>(
+        expected.data(), expected.size(), back.data(),
+        lguim::ParallelOptions(4, 1000));
+    COMPARE_EQ(result.invalidCount, 3u);
+    COMPARE_EQ(result.firstInvalid, 31337u);
+    COMPARE_EQ(back[0], A::A1);
+    COMPARE_EQ(back[99998], A::A3);
+
+    result = lguim::parallelConvertBatch<SUT, lguim::side::Internal>(
+        expected.data(), 31337, back.data(), lguim::ParallelOptions(4, 1000));
+    ASSERT(result.ok());
+    COMPARE_EQ(result.firstInvalid, 31337u);
+
+    // Empty input
+    result = lguim::parallelConvertBatch<SUT, TB>(
+        internal.data(), 0, expected.data(), lguim::ParallelOptions(4));
+    ASSERT(result.ok());
+    COMPARE_EQ(result.firstInvalid, 0u);
+END_TEST
@@ -0,0 +1,51 @@
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A { A1, A2, A3, A4, A5 };
+enum class B { B1, B2, B3, B4, B5 = -1 };
+using SUT = lguim::SecureEnumConverter<A, B>;
+
+#define SEC_TYPE SUT
+#define SEC_ENGINE lguim::engine::Permutation
+#define SEC_MAPPING             \
+    SEC_EQUIV(A::A1, B::B3)     \
+    SEC_EQUIV(A::A2, B::B1)     \
+    SEC_EQUIV(A::A3, B::B4)     \
+    SEC_EQUIV(A::A4, B::B2)     \
+    SEC_ORPHAN_INT(A::A5)       \
+    SEC_ORPHAN_EXT(B::B5)
+#include "lguim/secureenumconverter.inc"
+
+START_TEST(Permutation)
+    // toExternalOpt
+    COMPARE_EQ(SUT::toExternalOpt(A::A1), B::B3);
+    COMPARE_EQ(SUT::toExternalOpt(A::A2), B::B1);
+    COMPARE_EQ(SUT::toExternalOpt(A::A3), B::B4);
+    COMPARE_EQ(SUT::toExternalOpt(A::A4), B::B2);
+    COMPARE_EQ(SUT::toExternalOpt(A::A5), std::nullopt);
+    COMPARE_EQ(SUT::toExternalOpt(static_cast<A>(-1)), std::nullopt);
+
+    // toInternalOpt
+    COMPARE_EQ(SUT::toInternalOpt(B::B1), A::A2);
+    COMPARE_EQ(SUT::toInternalOpt(B::B2), A::A4);
+    COMPARE_EQ(SUT::toInternalOpt(B::B3), A::A1);
+    COMPARE_EQ(SUT::toInternalOpt(B::B4), A::A3);
+    COMPARE_EQ(SUT::toInternalOpt(B::B5), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(4)), std::nullopt);
+
+    // toExternalOrThrow
+    COMPARE_EQ(SUT::toExternalOrThrow(A::A1), B::B3);
+    THROWS(std::invalid_argument, SUT::toExternalOrThrow(A::A5));
+
+    // toInternalOrThrow
+    COMPARE_EQ(SUT::toInternalOrThrow(B::B4), A::A3);
+    THROWS(std::invalid_argument, SUT::toInternalOrThrow(B::B5));
+
+    // convertibleInternalValues
+    std::set<A> expectedInternalValues { A::A1, A::A2, A::A3, A::A4 };
+    COMPARE_EQ(SUT::convertibleInternalValues(), expectedInternalValues);
+
+    // convertibleInternalValues
+    std::set<B> expectedExternalValues { B::B1, B::B2, B::B3, B::B4 };
+    COMPARE_EQ(SUT::convertibleExternalValues(), expectedExternalValues);
+END_TEST
@@ -0,0 +1,75 @@
+#include <cstdint>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A : std::uint8_t { A1, A2, A2_old, A3, A4 }; struct TA;
+enum class B : std::int32_t { B1 = 10, B2 = 200, B3 = 3000, B4 = 4 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) \
+    SEC_EQUIV(A::A2, B::B2) \
+    SEC_PROJ_I2E(A::A2_old, B::B2) \
+    SEC_EQUIV(A::A3, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+template <typename T>
+bool sameRuns(
+    const std::vector<lguim::Run<T>>& actual, std::size_t count,
+    const std::vector<lguim::Run<T>>& expected) {
+    if (count != expected.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (actual[i].value != expected[i].value
+            || actual[i].length != expected[i].length) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+START_TEST(Runs)
+    // Projected runs merged
+    const std::vector<lguim::Run<A>> internal {
+        { A::A1, 3 }, { A::A2, 1000 }, { A::A2_old, 24 }, { A::A2, 1 },
+        { A::A3, 5 }, { A::A4, 7 }, { A::A3, 2 }, { A::A1, 1 },
+    };
+
+    std::vector<lguim::Run<B>> external(internal.size());
+    lguim::RunResult result = SUT::toExternalRuns(
+        internal.data(), internal.size(), external.data());
+    COMPARE_EQ(result.invalidCount, 1u);
+    COMPARE_EQ(result.firstInvalid, 5u);
+    ASSERT(!result.ok());
+    ASSERT(sameRuns(external, result.runCount, {
+        { B::B1, 3 }, { B::B2, 1025 }, { B::B3, 5 }, { B::B3, 2 },
+        { B::B1, 1 },
+    }));
+
+    // Other direction, with tags
+    std::vector<lguim::Run<A>> back(external.size());
+    result = SUT::convertRuns<TA>(external.data(), 4, back.data());
+    ASSERT(result.ok());
+    COMPARE_EQ(result.firstInvalid, 4u);
+    ASSERT(sameRuns(back, result.runCount, {
+        { A::A1, 3 }, { A::A2, 1025 }, { A::A3, 7 },
+    }));
+
+    const std::vector<lguim::Run<B>> orphans { { B::B4, 1 }, { B::B4, 2 } };
+    result = SUT::convertRuns<TA>(orphans.data(), orphans.size(), back.data());
+    COMPARE_EQ(result.runCount, 0u);
+    COMPARE_EQ(result.invalidCount, 2u);
+    COMPARE_EQ(result.firstInvalid, 0u);
+
+    result = SUT::toInternalRuns(orphans.data(), 0, back.data());
+    COMPARE_EQ(result.runCount, 0u);
+    ASSERT(result.ok());
+END_TEST
@@ -0,0 +1,538 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+// Mappings fitting each kernel: 8-bit values spanning 14, 24 and 40 values,
+// 16 and 32-bit values gathered from a table, to 8, 16 and 32-bit values,
+// and constant offsets. The kernels available on the running CPU are
+// compared with the scalar conversions.
+
+enum class P : std::uint8_t {
+    P0 = 3, P1 = 4, P2 = 5, P3 = 6, P4 = 7, P5 = 8, P6 = 9, P7 = 10, P8 = 11,
+    P9 = 12, P10 = 13, P11 = 14, P12 = 15, P13 = 16,
+};
+enum class Q : std::uint8_t {
+    Q0 = 200, Q1 = 201, Q2 = 202, Q3 = 203, Q4 = 204, Q5 = 205, Q6 = 206,
+    Q7 = 207, Q8 = 208, Q9 = 209, Q10 = 210, Q11 = 211, Q12 = 212, Q13 = 213,
+};
+using Bytes14 = lguim::SecureEnumConverter<P, Q>;
+
+#define SEC_TYPE Bytes14
+#define SEC_MAPPING \
+    SEC_EQUIV(P::P0, Q::Q3) \
+    SEC_EQUIV(P::P1, Q::Q8) \
+    SEC_EQUIV(P::P2, Q::Q0) \
+    SEC_EQUIV(P::P3, Q::Q5) \
+    SEC_EQUIV(P::P4, Q::Q10) \
+    SEC_EQUIV(P::P5, Q::Q2) \
+    SEC_EQUIV(P::P6, Q::Q7) \
+    SEC_EQUIV(P::P7, Q::Q12) \
+    SEC_EQUIV(P::P8, Q::Q4) \
+    SEC_EQUIV(P::P9, Q::Q9) \
+    SEC_EQUIV(P::P10, Q::Q1) \
+    SEC_EQUIV(P::P11, Q::Q6) \
+    SEC_EQUIV(P::P12, Q::Q11) \
+    SEC_ORPHAN_INT(P::P13) \
+    SEC_ORPHAN_EXT(Q::Q13)
+#include "lguim/secureenumconverter.inc"
+
+enum class X : std::uint8_t {
+    X0 = 50, X1 = 51, X2 = 52, X3 = 53, X4 = 54, X5 = 55, X6 = 56, X7 = 57,
+    X8 = 58, X9 = 59, X10 = 60, X11 = 61, X12 = 62, X13 = 63, X14 = 64,
+    X15 = 65, X16 = 66, X17 = 67, X18 = 68, X19 = 69, X20 = 70, X21 = 71,
+    X22 = 72, X23 = 73,
+};
+enum class Y : std::int8_t {
+    Y0 = -12, Y1 = -11, Y2 = -10, Y3 = -9, Y4 = -8, Y5 = -7, Y6 = -6, Y7 = -5,
+    Y8 = -4, Y9 = -3, Y10 = -2, Y11 = -1, Y12 = 0, Y13 = 1, Y14 = 2, Y15 = 3,
+    Y16 = 4, Y17 = 5, Y18 = 6, Y19 = 7, Y20 = 8, Y21 = 9, Y22 = 10, Y23 = 11,
+};
+using Bytes24 = lguim::SecureEnumConverter<X, Y>;
+
+#define SEC_TYPE Bytes24
+#define SEC_MAPPING \
+    SEC_EQUIV(X::X0, Y::Y3) \
+    SEC_EQUIV(X::X1, Y::Y8) \
+    SEC_EQUIV(X::X2, Y::Y13) \
+    SEC_EQUIV(X::X3, Y::Y18) \
+    SEC_EQUIV(X::X4, Y::Y0) \
+    SEC_EQUIV(X::X5, Y::Y5) \
+    SEC_EQUIV(X::X6, Y::Y10) \
+    SEC_EQUIV(X::X7, Y::Y15) \
+    SEC_EQUIV(X::X8, Y::Y20) \
+    SEC_EQUIV(X::X9, Y::Y2) \
+    SEC_EQUIV(X::X10, Y::Y7) \
+    SEC_EQUIV(X::X11, Y::Y12) \
+    SEC_EQUIV(X::X12, Y::Y17) \
+    SEC_EQUIV(X::X13, Y::Y22) \
+    SEC_EQUIV(X::X14, Y::Y4) \
+    SEC_EQUIV(X::X15, Y::Y9) \
+    SEC_EQUIV(X::X16, Y::Y14) \
+    SEC_EQUIV(X::X17, Y::Y19) \
+    SEC_EQUIV(X::X18, Y::Y1) \
+    SEC_EQUIV(X::X19, Y::Y6) \
+    SEC_EQUIV(X::X20, Y::Y11) \
+    SEC_EQUIV(X::X21, Y::Y16) \
+    SEC_EQUIV(X::X22, Y::Y21) \
+    SEC_ORPHAN_INT(X::X23) \
+    SEC_ORPHAN_EXT(Y::Y23)
+#include "lguim/secureenumconverter.inc"
+
+enum class R : std::int8_t {
+    R0 = -20, R1 = -19, R2 = -18, R3 = -17, R4 = -16, R5 = -15, R6 = -14,
+    R7 = -13, R8 = -12, R9 = -11, R10 = -10, R11 = -9, R12 = -8, R13 = -7,
+    R14 = -6, R15 = -5, R16 = -4, R17 = -3, R18 = -2, R19 = -1, R20 = 0,
+    R21 = 1, R22 = 2, R23 = 3, R24 = 4, R25 = 5, R26 = 6, R27 = 7, R28 = 8,
+    R29 = 9, R30 = 10, R31 = 11, R32 = 12, R33 = 13, R34 = 14, R35 = 15,
+    R36 = 16, R37 = 17, R38 = 18, R39 = 19,
+};
+enum class S : std::uint8_t {
+    S0 = 0, S1 = 2, S2 = 4, S3 = 6, S4 = 8, S5 = 10, S6 = 12, S7 = 14,
+    S8 = 16, S9 = 18, S10 = 20, S11 = 22, S12 = 24, S13 = 26, S14 = 28,
+    S15 = 30, S16 = 32, S17 = 34, S18 = 36, S19 = 38, S20 = 40, S21 = 42,
+    S22 = 44, S23 = 46, S24 = 48, S25 = 50, S26 = 52, S27 = 54, S28 = 56,
+    S29 = 58, S30 = 60, S31 = 62, S32 = 64, S33 = 66, S34 = 68, S35 = 70,
+    S36 = 72, S37 = 74, S38 = 76, S39 = 78,
+};
+using Bytes40 = lguim::SecureEnumConverter<R, S>;
+
+#define SEC_TYPE Bytes40
+#define SEC_MAPPING \
+    SEC_EQUIV(R::R0, S::S3) \
+    SEC_EQUIV(R::R1, S::S8) \
+    SEC_EQUIV(R::R2, S::S13) \
+    SEC_EQUIV(R::R3, S::S18) \
+    SEC_EQUIV(R::R4, S::S23) \
+    SEC_EQUIV(R::R5, S::S28) \
+    SEC_EQUIV(R::R6, S::S33) \
+    SEC_EQUIV(R::R7, S::S38) \
+    SEC_EQUIV(R::R8, S::S4) \
+    SEC_EQUIV(R::R9, S::S9) \
+    SEC_EQUIV(R::R10, S::S14) \
+    SEC_EQUIV(R::R11, S::S19) \
+    SEC_EQUIV(R::R12, S::S24) \
+    SEC_EQUIV(R::R13, S::S29) \
+    SEC_EQUIV(R::R14, S::S34) \
+    SEC_EQUIV(R::R15, S::S0) \
+    SEC_EQUIV(R::R16, S::S5) \
+    SEC_EQUIV(R::R17, S::S10) \
+    SEC_EQUIV(R::R18, S::S15) \
+    SEC_EQUIV(R::R19, S::S20) \
+    SEC_EQUIV(R::R20, S::S25) \
+    SEC_EQUIV(R::R21, S::S30) \
+    SEC_EQUIV(R::R22, S::S35) \
+    SEC_EQUIV(R::R23, S::S1) \
+    SEC_EQUIV(R::R24, S::S6) \
+    SEC_EQUIV(R::R25, S::S11) \
+    SEC_EQUIV(R::R26, S::S16) \
+    SEC_EQUIV(R::R27, S::S21) \
+    SEC_EQUIV(R::R28, S::S26) \
+    SEC_EQUIV(R::R29, S::S31) \
+    SEC_EQUIV(R::R30, S::S36) \
+    SEC_EQUIV(R::R31, S::S2) \
+    SEC_EQUIV(R::R32, S::S7) \
+    SEC_EQUIV(R::R33, S::S12) \
+    SEC_EQUIV(R::R34, S::S17) \
+    SEC_EQUIV(R::R35, S::S22) \
+    SEC_EQUIV(R::R36, S::S27) \
+    SEC_EQUIV(R::R37, S::S32) \
+    SEC_EQUIV(R::R38, S::S37) \
+    SEC_ORPHAN_INT(R::R39) \
+    SEC_ORPHAN_EXT(S::S39)
+#include "lguim/secureenumconverter.inc"
+
+enum class T : std::int16_t {
+    T0 = -500, T1 = -493, T2 = -486, T3 = -479, T4 = -472, T5 = -465,
+    T6 = -458, T7 = -451, T8 = -444, T9 = -437, T10 = -430, T11 = -423,
+    T12 = -416, T13 = -409, T14 = -402, T15 = -395, T16 = -388, T17 = -381,
+    T18 = -374, T19 = -367, T20 = -360, T21 = -353, T22 = -346, T23 = -339,
+    T24 = -332, T25 = -325, T26 = -318, T27 = -311, T28 = -304, T29 = -297,
+};
+enum class U : std::uint8_t {
+    U0 = 0, U1 = 1, U2 = 2, U3 = 3, U4 = 4, U5 = 5, U6 = 6, U7 = 7, U8 = 8,
+    U9 = 9, U10 = 10, U11 = 11, U12 = 12, U13 = 13, U14 = 14, U15 = 15,
+    U16 = 16, U17 = 17, U18 = 18, U19 = 19, U20 = 20, U21 = 21, U22 = 22,
+    U23 = 23, U24 = 24, U25 = 25, U26 = 26, U27 = 27, U28 = 28, U29 = 29,
+};
+using Gather16 = lguim::SecureEnumConverter<T, U>;
+
+#define SEC_TYPE Gather16
+#define SEC_MAPPING \
+    SEC_EQUIV(T::T0, U::U3) \
+    SEC_EQUIV(T::T1, U::U8) \
+    SEC_EQUIV(T::T2, U::U13) \
+    SEC_EQUIV(T::T3, U::U18) \
+    SEC_EQUIV(T::T4, U::U23) \
+    SEC_EQUIV(T::T5, U::U28) \
+    SEC_EQUIV(T::T6, U::U4) \
+    SEC_EQUIV(T::T7, U::U9) \
+    SEC_EQUIV(T::T8, U::U14) \
+    SEC_EQUIV(T::T9, U::U19) \
+    SEC_EQUIV(T::T10, U::U24) \
+    SEC_EQUIV(T::T11, U::U0) \
+    SEC_EQUIV(T::T12, U::U5) \
+    SEC_EQUIV(T::T13, U::U10) \
+    SEC_EQUIV(T::T14, U::U15) \
+    SEC_EQUIV(T::T15, U::U20) \
+    SEC_EQUIV(T::T16, U::U25) \
+    SEC_EQUIV(T::T17, U::U1) \
+    SEC_EQUIV(T::T18, U::U6) \
+    SEC_EQUIV(T::T19, U::U11) \
+    SEC_EQUIV(T::T20, U::U16) \
+    SEC_EQUIV(T::T21, U::U21) \
+    SEC_EQUIV(T::T22, U::U26) \
+    SEC_EQUIV(T::T23, U::U2) \
+    SEC_EQUIV(T::T24, U::U7) \
+    SEC_EQUIV(T::T25, U::U12) \
+    SEC_EQUIV(T::T26, U::U17) \
+    SEC_EQUIV(T::T27, U::U22) \
+    SEC_EQUIV(T::T28, U::U27) \
+    SEC_ORPHAN_INT(T::T29) \
+    SEC_ORPHAN_EXT(U::U29)
+#include "lguim/secureenumconverter.inc"
+
+enum class V : std::uint32_t {
+    V0 = 1000, V1 = 1013, V2 = 1026, V3 = 1039, V4 = 1052, V5 = 1065,
+    V6 = 1078, V7 = 1091, V8 = 1104, V9 = 1117, V10 = 1130, V11 = 1143,
+    V12 = 1156, V13 = 1169, V14 = 1182, V15 = 1195, V16 = 1208, V17 = 1221,
+    V18 = 1234, V19 = 1247, V20 = 1260, V21 = 1273, V22 = 1286, V23 = 1299,
+    V24 = 1312, V25 = 1325, V26 = 1338, V27 = 1351, V28 = 1364, V29 = 1377,
+    V30 = 1390, V31 = 1403, V32 = 1416, V33 = 1429, V34 = 1442, V35 = 1455,
+    V36 = 1468, V37 = 1481, V38 = 1494, V39 = 1507, V40 = 1520, V41 = 1533,
+    V42 = 1546, V43 = 1559, V44 = 1572, V45 = 1585, V46 = 1598, V47 = 1611,
+    V48 = 1624, V49 = 1637,
+};
+enum class W : std::int16_t {
+    W0 = 0, W1 = -3, W2 = -6, W3 = -9, W4 = -12, W5 = -15, W6 = -18, W7 = -21,
+    W8 = -24, W9 = -27, W10 = -30, W11 = -33, W12 = -36, W13 = -39, W14 = -42,
+    W15 = -45, W16 = -48, W17 = -51, W18 = -54, W19 = -57, W20 = -60,
+    W21 = -63, W22 = -66, W23 = -69, W24 = -72, W25 = -75, W26 = -78,
+    W27 = -81, W28 = -84, W29 = -87, W30 = -90, W31 = -93, W32 = -96,
+    W33 = -99, W34 = -102, W35 = -105, W36 = -108, W37 = -111, W38 = -114,
+    W39 = -117, W40 = -120, W41 = -123, W42 = -126, W43 = -129, W44 = -132,
+    W45 = -135, W46 = -138, W47 = -141, W48 = -144, W49 = -147,
+};
+using Gather32 = lguim::SecureEnumConverter<V, W>;
+
+#define SEC_TYPE Gather32
+#define SEC_MAPPING \
+    SEC_EQUIV(V::V0, W::W3) \
+    SEC_EQUIV(V::V1, W::W8) \
+    SEC_EQUIV(V::V2, W::W13) \
+    SEC_EQUIV(V::V3, W::W18) \
+    SEC_EQUIV(V::V4, W::W23) \
+    SEC_EQUIV(V::V5, W::W28) \
+    SEC_EQUIV(V::V6, W::W33) \
+    SEC_EQUIV(V::V7, W::W38) \
+    SEC_EQUIV(V::V8, W::W43) \
+    SEC_EQUIV(V::V9, W::W48) \
+    SEC_EQUIV(V::V10, W::W4) \
+    SEC_EQUIV(V::V11, W::W9) \
+    SEC_EQUIV(V::V12, W::W14) \
+    SEC_EQUIV(V::V13, W::W19) \
+    SEC_EQUIV(V::V14, W::W24) \
+    SEC_EQUIV(V::V15, W::W29) \
+    SEC_EQUIV(V::V16, W::W34) \
+    SEC_EQUIV(V::V17, W::W39) \
+    SEC_EQUIV(V::V18, W::W44) \
+    SEC_EQUIV(V::V19, W::W0) \
+    SEC_EQUIV(V::V20, W::W5) \
+    SEC_EQUIV(V::V21, W::W10) \
+    SEC_EQUIV(V::V22, W::W15) \
+    SEC_EQUIV(V::V23, W::W20) \
+    SEC_EQUIV(V::V24, W::W25) \
+    SEC_EQUIV(V::V25, W::W30) \
+    SEC_EQUIV(V::V26, W::W35) \
+    SEC_EQUIV(V::V27, W::W40) \
+    SEC_EQUIV(V::V28, W::W45) \
+    SEC_EQUIV(V::V29, W::W1) \
+    SEC_EQUIV(V::V30, W::W6) \
+    SEC_EQUIV(V::V31, W::W11) \
+    SEC_EQUIV(V::V32, W::W16) \
+    SEC_EQUIV(V::V33, W::W21) \
+    SEC_EQUIV(V::V34, W::W26) \
+    SEC_EQUIV(V::V35, W::W31) \
+    SEC_EQUIV(V::V36, W::W36) \
+    SEC_EQUIV(V::V37, W::W41) \
+    SEC_EQUIV(V::V38, W::W46) \
+    SEC_EQUIV(V::V39, W::W2) \
+    SEC_EQUIV(V::V40, W::W7) \
+    SEC_EQUIV(V::V41, W::W12) \
+    SEC_EQUIV(V::V42, W::W17) \
+    SEC_EQUIV(V::V43, W::W22) \
+    SEC_EQUIV(V::V44, W::W27) \
+    SEC_EQUIV(V::V45, W::W32) \
+    SEC_EQUIV(V::V46, W::W37) \
+    SEC_EQUIV(V::V47, W::W42) \
+    SEC_EQUIV(V::V48, W::W47) \
+    SEC_ORPHAN_INT(V::V49) \
+    SEC_ORPHAN_EXT(W::W49)
+#include "lguim/secureenumconverter.inc"
+
+// Enumerations of the default underlying type, `int`
+enum class M {
+    M0 = -100, M1 = -91, M2 = -82, M3 = -73, M4 = -64, M5 = -55, M6 = -46,
+    M7 = -37, M8 = -28, M9 = -19, M10 = -10, M11 = -1, M12 = 8, M13 = 17,
+    M14 = 26, M15 = 35, M16 = 44, M17 = 53, M18 = 62, M19 = 71,
+};
+enum class N {
+    N0 = -7, N1 = 99993, N2 = 199993, N3 = 299993, N4 = 399993, N5 = 499993,
+    N6 = 599993, N7 = 699993, N8 = 799993, N9 = 899993, N10 = 999993,
+    N11 = 1099993, N12 = 1199993, N13 = 1299993, N14 = 1399993, N15 = 1499993,
+    N16 = 1599993, N17 = 1699993, N18 = 1799993, N19 = 1899993,
+};
+using Gather32Wide = lguim::SecureEnumConverter<M, N>;
+
+#define SEC_TYPE Gather32Wide
+#define SEC_MAPPING \
+    SEC_EQUIV(M::M0, N::N0) \
+    SEC_EQUIV(M::M1, N::N7) \
+    SEC_EQUIV(M::M2, N::N14) \
+    SEC_EQUIV(M::M3, N::N1) \
+    SEC_EQUIV(M::M4, N::N8) \
+    SEC_EQUIV(M::M5, N::N15) \
+    SEC_EQUIV(M::M6, N::N2) \
+    SEC_EQUIV(M::M7, N::N9) \
+    SEC_EQUIV(M::M8, N::N16) \
+    SEC_EQUIV(M::M9, N::N3) \
+    SEC_EQUIV(M::M10, N::N10) \
+    SEC_EQUIV(M::M11, N::N17) \
+    SEC_EQUIV(M::M12, N::N4) \
+    SEC_EQUIV(M::M13, N::N11) \
+    SEC_EQUIV(M::M14, N::N18) \
+    SEC_EQUIV(M::M15, N::N5) \
+    SEC_EQUIV(M::M16, N::N12) \
+    SEC_EQUIV(M::M17, N::N19) \
+    SEC_EQUIV(M::M18, N::N6) \
+    SEC_ORPHAN_INT(M::M19) \
+    SEC_ORPHAN_EXT(N::N13)
+#include "lguim/secureenumconverter.inc"
+
+// Mappings adding a constant: 8, 16 and 32-bit, the last one an identity
+enum class G : std::int8_t {
+    G0 = -5, G1, G2, G3, G4, G5, G6, G7, G8, G9, G10 = 40,
+};
+enum class H : std::uint8_t {
+    H0 = 120, H1, H2, H3, H4, H5, H6, H7, H8, H9, H10 = 3,
+};
+using Affine8 = lguim::SecureEnumConverter<G, H>;
+
+#define SEC_TYPE Affine8
+#define SEC_MAPPING \
+    SEC_EQUIV(G::G0, H::H0) \
+    SEC_EQUIV(G::G1, H::H1) \
+    SEC_EQUIV(G::G2, H::H2) \
+    SEC_EQUIV(G::G3, H::H3) \
+    SEC_EQUIV(G::G4, H::H4) \
+    SEC_EQUIV(G::G5, H::H5) \
+    SEC_EQUIV(G::G6, H::H6) \
+    SEC_EQUIV(G::G7, H::H7) \
+    SEC_EQUIV(G::G8, H::H8) \
+    SEC_EQUIV(G::G9, H::H9) \
+    SEC_ORPHAN_INT(G::G10) \
+    SEC_ORPHAN_EXT(H::H10)
+#include "lguim/secureenumconverter.inc"
+
+enum class I : std::uint16_t {
+    I0 = 1000, I1, I2, I3, I4, I5, I6, I7, I8, I9, I10, I11,
+};
+enum class J : std::int16_t {
+    J0 = -12, J1, J2, J3, J4, J5, J6, J7, J8, J9, J10, J11,
+};
+using Affine16 = lguim::SecureEnumConverter<I, J>;
+
+#define SEC_TYPE Affine16
+#define SEC_MAPPING \
+    SEC_EQUIV(I::I0, J::J0) \
+    SEC_EQUIV(I::I1, J::J1) \
+    SEC_EQUIV(I::I2, J::J2) \
+    SEC_EQUIV(I::I3, J::J3) \
+    SEC_EQUIV(I::I4, J::J4) \
+    SEC_EQUIV(I::I5, J::J5) \
+    SEC_EQUIV(I::I6, J::J6) \
+    SEC_EQUIV(I::I7, J::J7) \
+    SEC_EQUIV(I::I8, J::J8) \
+    SEC_EQUIV(I::I9, J::J9) \
+    SEC_EQUIV(I::I10, J::J10) \
+    SEC_EQUIV(I::I11, J::J11)
+#include "lguim/secureenumconverter.inc"
+
+enum class K : std::uint32_t { K0 = 70000, K1, K2, K3, K4, K5, K6, K7 };
+enum class L : std::uint32_t { L0 = 70000, L1, L2, L3, L4, L5, L6, L7 };
+using Identity32 = lguim::SecureEnumConverter<K, L>;
+
+#define SEC_TYPE Identity32
+#define SEC_MAPPING \
+    SEC_EQUIV(K::K0, L::L0) \
+    SEC_EQUIV(K::K1, L::L1) \
+    SEC_EQUIV(K::K2, L::L2) \
+    SEC_EQUIV(K::K3, L::L3) \
+    SEC_EQUIV(K::K4, L::L4) \
+    SEC_EQUIV(K::K5, L::L5) \
+    SEC_EQUIV(K::K6, L::L6) \
+    SEC_EQUIV(K::K7, L::L7)
+#include "lguim/secureenumconverter.inc"
+
+using lguim::priv::Isa;
+
+template <typename SUT>
+using ToExternal = lguim::priv::SimdBatch<
+    lguim::priv::EngineConverter<
+        typename lguim::priv::Mapping<SUT>::Engine, true, SUT>,
+    true, SUT>;
+
+// Random representations from `margin` values below `lowest` to `margin`
+// values above `highest`, within the range of the underlying type.
+template <typename T>
+std::vector<T> randomInputs(T lowest, T highest, long long margin) {
+    using Underlying = typename std::underlying_type<T>::type;
+    using Limits = std::numeric_limits<Underlying>;
+    const long long low = std::max(
+        static_cast<long long>(lguim::priv::toUnderlying(lowest)) - margin,
+        static_cast<long long>(Limits::lowest()));
+    const long long high = std::min(
+        static_cast<long long>(lguim::priv::toUnderlying(highest)) + margin,
+        static_cast<long long>(Limits::max()));
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<long long> pick(low, high);
+
+    std::vector<T> inputs;
+    for (std::size_t i = 0; i < 1037; ++i) {
+        inputs.push_back(
+            static_cast<T>(static_cast<Underlying>(pick(generator))));
+    }
+    return inputs;
+}
+
+// Inputs around the range of the enumeration, most of them valid.
+template <typename T>
+std::vector<T> nearInputs(T lowest, T highest)
+{ return randomInputs(lowest, highest, 3); }
+
+// Inputs up to 4 times the span of the enumeration, and at least 256
+// values, away from its range, most of them invalid: the whole underlying
+// type for the 8-bit kernels.
+template <typename T>
+std::vector<T> wideInputs(T lowest, T highest) {
+    const long long span =
+        static_cast<long long>(lguim::priv::toUnderlying(highest))
+            - static_cast<long long>(lguim::priv::toUnderlying(lowest));
+    return randomInputs(lowest, highest, std::max(4 * span, 256LL));
+}
+
+// Whether the kernel for `isa` gives the same outputs, result and validity
+// bits as the scalar conversion, with outputs of invalid values left
+// untouched.
+template <typename SUT>
+bool sameAsScalar(Isa isa, const std::vector<typename SUT::Internal>& inputs) {
+    using External = typename SUT::External;
+    const External untouched = static_cast<External>(77);
+
+    std::vector<External> expected(inputs.size(), untouched);
+    std::size_t invalidCount = 0;
+    std::size_t firstInvalid = inputs.size();
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        const auto converted = SUT::toExternalOpt(inputs[i]);
+        if (converted) {
+            expected[i] = *converted;
+        } else if (invalidCount++ == 0) {
+            firstInvalid = i;
+        }
+    }
+
+    std::vector<External> outputs(inputs.size(), untouched);
+    const lguim::BatchResult result = ToExternal<SUT>::convertWith(
+        isa, inputs.data(), inputs.size(), outputs.data());
+
+    // Validity bits of the whole blocks, over bytes poisoned beforehand
+    std::vector<External> blockOutputs(inputs.size(), untouched);
+    std::vector<std::uint8_t> validity((inputs.size() + 7) / 8, 0xaa);
+    lguim::priv::KernelResult blocks{{0, inputs.size()}, validity.data()};
+    const std::size_t done = ToExternal<SUT>::convertBlocks(
+        isa, inputs.data(), inputs.size(), blockOutputs.data(), blocks);
+
+    bool sameValidity = done % 8 == 0 && done <= inputs.size();
+    for (std::size_t i = 0; sameValidity && i < done; ++i) {
+        const bool bit = (validity[i / 8] >> (i % 8)) & 1;
+        sameValidity = bit == static_cast<bool>(
+            SUT::toExternalOpt(inputs[i]));
+    }
+
+    return outputs == expected
+        && result.invalidCount == invalidCount
+        && result.firstInvalid == firstInvalid
+        && sameValidity;
+}
+
+template <typename SUT>
+bool allKernelsAgree(const std::vector<typename SUT::Internal>& inputs) {
+    const Isa best = lguim::priv::detectIsa();
+    bool agree = true;
+    for (Isa isa : { Isa::Scalar, Isa::Sse42, Isa::Avx2, Isa::Avx512Vbmi }) {
+        if (isa <= best) {
+            agree = sameAsScalar<SUT>(isa, inputs) && agree;
+        }
+    }
+    return agree;
+}
+
+START_TEST(Simd)
+    // Kernels available for each mapping
+    ASSERT(ToExternal<Bytes14>::supports(Isa::Sse42));
+    ASSERT(ToExternal<Bytes14>::supports(Isa::Avx2));
+    ASSERT(!ToExternal<Bytes24>::supports(Isa::Sse42));
+    ASSERT(ToExternal<Bytes24>::supports(Isa::Avx2));
+    ASSERT(!ToExternal<Bytes40>::supports(Isa::Avx2));
+    ASSERT(ToExternal<Bytes40>::supports(Isa::Avx512Vbmi));
+    ASSERT(ToExternal<Gather16>::supports(Isa::Avx2));
+    ASSERT(ToExternal<Gather32>::supports(Isa::Avx2));
+    ASSERT(!ToExternal<Gather32>::supports(Isa::Sse42));
+    ASSERT(ToExternal<Gather32Wide>::supports(Isa::Avx2));
+    ASSERT(ToExternal<Affine8>::supports(Isa::Sse42));
+    ASSERT(!ToExternal<Affine8>::supports(Isa::Scalar));
+    ASSERT(ToExternal<Affine16>::supports(Isa::Avx2));
+    ASSERT(ToExternal<Identity32>::supports(Isa::Sse42));
+    ASSERT(lguim::priv::AffineKernels<ToExternal<Identity32>::Source>
+        ::identity);
+
+    // Mostly valid inputs
+    ASSERT(allKernelsAgree<Bytes14>(nearInputs(P::P0, P::P13)));
+    ASSERT(allKernelsAgree<Bytes24>(nearInputs(X::X0, X::X23)));
+    ASSERT(allKernelsAgree<Bytes40>(nearInputs(R::R0, R::R39)));
+    ASSERT(allKernelsAgree<Gather16>(nearInputs(T::T0, T::T29)));
+    ASSERT(allKernelsAgree<Gather32>(nearInputs(V::V0, V::V49)));
+    ASSERT(allKernelsAgree<Gather32Wide>(nearInputs(M::M0, M::M19)));
+    ASSERT(allKernelsAgree<Affine8>(nearInputs(G::G0, G::G10)));
+    ASSERT(allKernelsAgree<Affine16>(nearInputs(I::I0, I::I11)));
+    ASSERT(allKernelsAgree<Identity32>(nearInputs(K::K0, K::K7)));
+
+    // Mostly invalid inputs
+    ASSERT(allKernelsAgree<Bytes14>(wideInputs(P::P0, P::P13)));
+    ASSERT(allKernelsAgree<Bytes24>(wideInputs(X::X0, X::X23)));
+    ASSERT(allKernelsAgree<Bytes40>(wideInputs(R::R0, R::R39)));
+    ASSERT(allKernelsAgree<Gather16>(wideInputs(T::T0, T::T29)));
+    ASSERT(allKernelsAgree<Gather32>(wideInputs(V::V0, V::V49)));
+    ASSERT(allKernelsAgree<Gather32Wide>(wideInputs(M::M0, M::M19)));
+    ASSERT(allKernelsAgree<Affine8>(wideInputs(G::G0, G::G10)));
+    ASSERT(allKernelsAgree<Affine16>(wideInputs(I::I0, I::I11)));
+    ASSERT(allKernelsAgree<Identity32>(wideInputs(K::K0, K::K7)));
+
+    // Only valid values, through the public API
+    const std::vector<P> valid { P::P0, P::P12, P::P1 };
+    std::vector<P> inputs;
+    for (std::size_t i = 0; i < 100; ++i) {
+        inputs.push_back(valid[i % valid.size()]);
+    }
+    std::vector<Q> outputs(inputs.size());
+    const lguim::BatchResult result = Bytes14::toExternalBatch(
+        inputs.data(), inputs.size(), outputs.data());
+    ASSERT(result.ok());
+    COMPARE_EQ(outputs[99], Bytes14::toExternalOrThrow(P::P0));
+    COMPARE_EQ(outputs[98], Bytes14::toExternalOrThrow(P::P1));
+END_TEST
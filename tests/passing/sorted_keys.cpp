@@ -0,0 +1,63 @@
+#include <cstdint>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A { A1, A2, A3, A4, A2_old };
+enum class B : std::int32_t {
+    B1 = 0x0001, B2 = 0x0400, B3 = 0x8000, B5 = 100000, B3_old = -70000
+};
+using SUT = lguim::SecureEnumConverter<A, B>;
+
+#define SEC_TYPE SUT
+#define SEC_ENGINE lguim::engine::SortedKeys
+#define SEC_MAPPING                \
+    SEC_EQUIV(A::A1, B::B1)        \
+    SEC_EQUIV(A::A2, B::B2)        \
+    SEC_PROJ_I2E(A::A2_old, B::B2) \
+    SEC_PROJ_E2I(A::A3, B::B3_old) \
+    SEC_EQUIV(A::A3, B::B3)        \
+    SEC_ORPHAN_INT(A::A4)          \
+    SEC_ORPHAN_EXT(B::B5)
+#include "lguim/secureenumconverter.inc"
+
+START_TEST(SortedKeys)
+    // toExternalOpt
+    COMPARE_EQ(SUT::toExternalOpt(A::A1), B::B1);
+    COMPARE_EQ(SUT::toExternalOpt(A::A2), B::B2);
+    COMPARE_EQ(SUT::toExternalOpt(A::A3), B::B3);
+    COMPARE_EQ(SUT::toExternalOpt(A::A4), std::nullopt);
+    COMPARE_EQ(SUT::toExternalOpt(A::A2_old), B::B2);
+    COMPARE_EQ(SUT::toExternalOpt(static_cast<A>(-1)), std::nullopt);
+    COMPARE_EQ(SUT::toExternalOpt(static_cast<A>(5)), std::nullopt);
+
+    // toInternalOpt
+    COMPARE_EQ(SUT::toInternalOpt(B::B1), A::A1);
+    COMPARE_EQ(SUT::toInternalOpt(B::B2), A::A2);
+    COMPARE_EQ(SUT::toInternalOpt(B::B3), A::A3);
+    COMPARE_EQ(SUT::toInternalOpt(B::B5), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(B::B3_old), A::A3);
+
+    // toInternalOpt, values absent from the mapping, around and between
+    // the mapped ones
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(-70001)), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(0)), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(0x0401)), std::nullopt);
+    COMPARE_EQ(SUT::toInternalOpt(static_cast<B>(0x7FFFFFFF)), std::nullopt);
+
+    // toExternalOrThrow
+    COMPARE_EQ(SUT::toExternalOrThrow(A::A2_old), B::B2);
+    THROWS(std::invalid_argument, SUT::toExternalOrThrow(A::A4));
+
+    // toInternalOrThrow
+    COMPARE_EQ(SUT::toInternalOrThrow(B::B3_old), A::A3);
+    THROWS(std::invalid_argument, SUT::toInternalOrThrow(B::B5));
+
+    // convertibleInternalValues
+    std::set<A> expectedInternalValues { A::A1, A::A2, A::A3, A::A2_old };
+    COMPARE_EQ(SUT::convertibleInternalValues(), expectedInternalValues);
+
+    // convertibleInternalValues
+    std::set<B> expectedExternalValues { B::B1, B::B2, B::B3, B::B3_old };
+    COMPARE_EQ(SUT::convertibleExternalValues(), expectedExternalValues);
+END_TEST
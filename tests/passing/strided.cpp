@@ -0,0 +1,112 @@
+#include <cstdint>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A : std::uint8_t { A1, A2, A3, A4 }; struct TA;
+enum class B : std::uint8_t { B1 = 10, B2 = 20, B3 = 30, B4 = 40 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_EQUIV(A::A3, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+struct Record {
+    std::uint32_t id;
+    A status;
+    B converted;
+};
+
+struct WireRecord {
+    std::uint16_t flags;
+    B status;
+};
+
+#pragma pack(push, 1)
+struct PackedRecord {
+    std::uint8_t tag;
+    std::uint32_t id;
+    A status;
+};
+#pragma pack(pop)
+
+START_TEST(Strided)
+    std::vector<Record> records {
+        { 1, A::A1, B::B4 }, { 2, A::A4, B::B4 },
+        { 3, A::A3, B::B4 }, { 4, A::A2, B::B4 },
+    };
+
+    // From an array of records to another one
+    std::vector<WireRecord> wire(records.size(), WireRecord{7, B::B4});
+    lguim::BatchResult result = SUT::toExternalStrided(
+        &records[0].status, sizeof(Record), records.size(),
+        &wire[0].status, sizeof(WireRecord));
+    COMPARE_EQ(result.invalidCount, 1u);
+    COMPARE_EQ(result.firstInvalid, 1u);
+    COMPARE_EQ(wire[0].status, B::B2);
+    COMPARE_EQ(wire[1].status, B::B4);
+    COMPARE_EQ(wire[2].status, B::B3);
+    COMPARE_EQ(wire[3].status, B::B1);
+    COMPARE_EQ(wire[3].flags, 7u);
+
+    // Between two fields of the same records
+    result = SUT::convertStrided<TB>(
+        &records[0].status, sizeof(Record), records.size(),
+        &records[0].converted, sizeof(Record));
+    COMPARE_EQ(result.invalidCount, 1u);
+    COMPARE_EQ(records[2].converted, B::B3);
+    COMPARE_EQ(records[2].status, A::A3);
+    COMPARE_EQ(records[2].id, 3u);
+
+    // In the same field
+    result = SUT::toInternalStrided(
+        &wire[0].status, sizeof(WireRecord), wire.size(),
+        reinterpret_cast<A*>(&wire[0].status), sizeof(WireRecord));
+    COMPARE_EQ(result.firstInvalid, 1u);
+    COMPARE_EQ(reinterpret_cast<const A&>(wire[0].status), A::A1);
+    COMPARE_EQ(wire[1].status, B::B4);
+    COMPARE_EQ(reinterpret_cast<const A&>(wire[3].status), A::A2);
+
+    // Unaligned fields
+    unsigned char packed[3 * sizeof(PackedRecord)] = {};
+    PackedRecord* packedRecords = reinterpret_cast<PackedRecord*>(packed);
+    for (std::size_t i = 0; i < 3; ++i) {
+        packedRecords[i].status = static_cast<A>(i);
+    }
+    std::vector<B> contiguous(3);
+    result = SUT::HalfConverter<TB>::convertStrided(
+        reinterpret_cast<const A*>(packed + 5), sizeof(PackedRecord), 3,
+        contiguous.data(), sizeof(B));
+    ASSERT(result.ok());
+    COMPARE_EQ(contiguous, (std::vector<B> { B::B2, B::B1, B::B3 }));
+
+    // Contiguous arrays go through the batch conversion
+    std::vector<A> internal;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        internal.push_back(static_cast<A>(i % 4));
+    }
+    std::vector<B> strided(internal.size(), B::B4);
+    std::vector<B> batch(internal.size(), B::B4);
+    result = SUT::toExternalStrided(
+        internal.data(), sizeof(A), internal.size(), strided.data(), sizeof(B));
+    COMPARE_EQ(result.invalidCount, 250u);
+    COMPARE_EQ(result.firstInvalid, 3u);
+    SUT::toExternalBatch(internal.data(), internal.size(), batch.data());
+    COMPARE_EQ(strided, batch);
+
+    // In place on contiguous values
+    std::vector<B> values { B::B1, B::B4, B::B3 };
+    result = SUT::toInternalStrided(
+        values.data(), sizeof(B), values.size(),
+        reinterpret_cast<A*>(values.data()), sizeof(A));
+    COMPARE_EQ(result.firstInvalid, 1u);
+    COMPARE_EQ(reinterpret_cast<const A&>(values[0]), A::A2);
+    COMPARE_EQ(values[1], B::B4);
+    COMPARE_EQ(reinterpret_cast<const A&>(values[2]), A::A3);
+END_TEST
@@ -0,0 +1,277 @@
+#include <cstdint>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+// Validation of single values and of arrays, with the kernels available on
+// the running CPU: 8-bit values spanning 7, 11 and about 60 values, 16-bit
+// values within a bitmask, and 32-bit values too sparse for one.
+
+enum class A : std::uint8_t { A1 = 1, A2 = 3, A3 = 7, A4 = 9 }; struct TA;
+enum class B : std::int8_t { B1 = -5, B2 = 0, B3 = 5, B4 = 100 }; struct TB;
+using Small = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE Small
+#define SEC_INLINE
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_PROJ_I2E(A::A3, B::B1) \
+    SEC_PROJ_E2I(A::A1, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+// Tests of constants, with the inline mapping
+static_assert(Small::isConvertibleInternal(A::A3), "Projection");
+static_assert(!Small::isConvertibleInternal(A::A4), "Orphan");
+static_assert(!Small::isConvertibleInternal(static_cast<A>(2)), "Unknown");
+static_assert(Small::isConvertibleExternal(B::B3), "Projection");
+
+enum class G : std::uint8_t {
+    G0 = 100, G1 = 101, G2 = 103, G3 = 104, G4 = 106, G5 = 107, G6 = 109,
+    G7 = 110, G8 = 112, G9 = 113, G10 = 115, G11 = 116, G12 = 118, G13 = 119,
+    G14 = 121, G15 = 122, G16 = 124, G17 = 125, G18 = 127, G19 = 128,
+    G20 = 130, G21 = 131, G22 = 133, G23 = 134, G24 = 136, G25 = 137,
+    G26 = 139, G27 = 140, G28 = 142, G29 = 143, G30 = 145, G31 = 146,
+    G32 = 148, G33 = 149, G34 = 151, G35 = 152, G36 = 154, G37 = 155,
+    G38 = 157, G39 = 158,
+};
+enum class H : std::uint8_t {
+    H0 = 0, H1 = 1, H2 = 2, H3 = 3, H4 = 4, H5 = 5, H6 = 6, H7 = 7, H8 = 8,
+    H9 = 9, H10 = 10, H11 = 11, H12 = 12, H13 = 13, H14 = 14, H15 = 15,
+    H16 = 16, H17 = 17, H18 = 18, H19 = 19, H20 = 20, H21 = 21, H22 = 22,
+    H23 = 23, H24 = 24, H25 = 25, H26 = 26, H27 = 27, H28 = 28, H29 = 29,
+    H30 = 30, H31 = 31, H32 = 32, H33 = 33, H34 = 34, H35 = 35, H36 = 36,
+    H37 = 37, H38 = 38, H39 = 39,
+};
+using Bytes60 = lguim::SecureEnumConverter<G, H>;
+
+#define SEC_TYPE Bytes60
+#define SEC_MAPPING \
+    SEC_EQUIV(G::G0, H::H39) \
+    SEC_EQUIV(G::G1, H::H38) \
+    SEC_EQUIV(G::G2, H::H37) \
+    SEC_EQUIV(G::G3, H::H36) \
+    SEC_ORPHAN_INT(G::G4) \
+    SEC_ORPHAN_EXT(H::H35) \
+    SEC_EQUIV(G::G5, H::H34) \
+    SEC_EQUIV(G::G6, H::H33) \
+    SEC_EQUIV(G::G7, H::H32) \
+    SEC_EQUIV(G::G8, H::H31) \
+    SEC_ORPHAN_INT(G::G9) \
+    SEC_ORPHAN_EXT(H::H30) \
+    SEC_EQUIV(G::G10, H::H29) \
+    SEC_EQUIV(G::G11, H::H28) \
+    SEC_EQUIV(G::G12, H::H27) \
+    SEC_EQUIV(G::G13, H::H26) \
+    SEC_ORPHAN_INT(G::G14) \
+    SEC_ORPHAN_EXT(H::H25) \
+    SEC_EQUIV(G::G15, H::H24) \
+    SEC_EQUIV(G::G16, H::H23) \
+    SEC_EQUIV(G::G17, H::H22) \
+    SEC_EQUIV(G::G18, H::H21) \
+    SEC_ORPHAN_INT(G::G19) \
+    SEC_ORPHAN_EXT(H::H20) \
+    SEC_EQUIV(G::G20, H::H19) \
+    SEC_EQUIV(G::G21, H::H18) \
+    SEC_EQUIV(G::G22, H::H17) \
+    SEC_EQUIV(G::G23, H::H16) \
+    SEC_ORPHAN_INT(G::G24) \
+    SEC_ORPHAN_EXT(H::H15) \
+    SEC_EQUIV(G::G25, H::H14) \
+    SEC_EQUIV(G::G26, H::H13) \
+    SEC_EQUIV(G::G27, H::H12) \
+    SEC_EQUIV(G::G28, H::H11) \
+    SEC_ORPHAN_INT(G::G29) \
+    SEC_ORPHAN_EXT(H::H10) \
+    SEC_EQUIV(G::G30, H::H9) \
+    SEC_EQUIV(G::G31, H::H8) \
+    SEC_EQUIV(G::G32, H::H7) \
+    SEC_EQUIV(G::G33, H::H6) \
+    SEC_ORPHAN_INT(G::G34) \
+    SEC_ORPHAN_EXT(H::H5) \
+    SEC_EQUIV(G::G35, H::H4) \
+    SEC_EQUIV(G::G36, H::H3) \
+    SEC_EQUIV(G::G37, H::H2) \
+    SEC_EQUIV(G::G38, H::H1) \
+    SEC_ORPHAN_INT(G::G39) \
+    SEC_ORPHAN_EXT(H::H0)
+#include "lguim/secureenumconverter.inc"
+
+enum class J : std::int16_t {
+    J0 = -1000, J1 = -903, J2 = -806, J3 = -709, J4 = -612, J5 = -515,
+    J6 = -418, J7 = -321, J8 = -224, J9 = -127, J10 = -30, J11 = 67,
+    J12 = 164, J13 = 261, J14 = 358, J15 = 455, J16 = 552, J17 = 649,
+    J18 = 746, J19 = 843, J20 = 940, J21 = 1037, J22 = 1134, J23 = 1231,
+    J24 = 1328, J25 = 1425, J26 = 1522, J27 = 1619, J28 = 1716, J29 = 1813,
+};
+enum class K : std::uint8_t {
+    K0 = 0, K1 = 1, K2 = 2, K3 = 3, K4 = 4, K5 = 5, K6 = 6, K7 = 7, K8 = 8,
+    K9 = 9, K10 = 10, K11 = 11, K12 = 12, K13 = 13, K14 = 14, K15 = 15,
+    K16 = 16, K17 = 17, K18 = 18, K19 = 19, K20 = 20, K21 = 21, K22 = 22,
+    K23 = 23, K24 = 24, K25 = 25, K26 = 26, K27 = 27, K28 = 28, K29 = 29,
+};
+using Mask16 = lguim::SecureEnumConverter<J, K>;
+
+#define SEC_TYPE Mask16
+#define SEC_MAPPING \
+    SEC_EQUIV(J::J0, K::K0) \
+    SEC_EQUIV(J::J1, K::K1) \
+    SEC_EQUIV(J::J2, K::K2) \
+    SEC_EQUIV(J::J3, K::K3) \
+    SEC_EQUIV(J::J4, K::K4) \
+    SEC_EQUIV(J::J5, K::K5) \
+    SEC_ORPHAN_INT(J::J6) \
+    SEC_ORPHAN_EXT(K::K6) \
+    SEC_EQUIV(J::J7, K::K7) \
+    SEC_EQUIV(J::J8, K::K8) \
+    SEC_EQUIV(J::J9, K::K9) \
+    SEC_EQUIV(J::J10, K::K10) \
+    SEC_EQUIV(J::J11, K::K11) \
+    SEC_EQUIV(J::J12, K::K12) \
+    SEC_ORPHAN_INT(J::J13) \
+    SEC_ORPHAN_EXT(K::K13) \
+    SEC_EQUIV(J::J14, K::K14) \
+    SEC_EQUIV(J::J15, K::K15) \
+    SEC_EQUIV(J::J16, K::K16) \
+    SEC_EQUIV(J::J17, K::K17) \
+    SEC_EQUIV(J::J18, K::K18) \
+    SEC_EQUIV(J::J19, K::K19) \
+    SEC_ORPHAN_INT(J::J20) \
+    SEC_ORPHAN_EXT(K::K20) \
+    SEC_EQUIV(J::J21, K::K21) \
+    SEC_EQUIV(J::J22, K::K22) \
+    SEC_EQUIV(J::J23, K::K23) \
+    SEC_EQUIV(J::J24, K::K24) \
+    SEC_EQUIV(J::J25, K::K25) \
+    SEC_EQUIV(J::J26, K::K26) \
+    SEC_ORPHAN_INT(J::J27) \
+    SEC_ORPHAN_EXT(K::K27) \
+    SEC_EQUIV(J::J28, K::K28) \
+    SEC_EQUIV(J::J29, K::K29)
+#include "lguim/secureenumconverter.inc"
+
+enum class L : std::int32_t { L1 = -5, L2 = 1, L3 = 70000, L4 = 9000000 };
+enum class M : std::uint8_t { M1, M2, M3, M4 };
+using Sparse32 = lguim::SecureEnumConverter<L, M>;
+
+#define SEC_TYPE Sparse32
+#define SEC_MAPPING \
+    SEC_EQUIV(L::L1, M::M1) \
+    SEC_EQUIV(L::L2, M::M2) \
+    SEC_EQUIV(L::L3, M::M3) \
+    SEC_EQUIV(L::L4, M::M4)
+#include "lguim/secureenumconverter.inc"
+
+using lguim::priv::Isa;
+
+template <typename SUT, bool toExternal>
+using Validation = lguim::priv::SimdValidation<
+    typename lguim::priv::Mapping<typename SUT::Converter>::Engine,
+    toExternal, typename SUT::Converter>;
+
+// Whether `isConvertible` agrees with the conversion for the
+// representations from `lowest` to `highest`.
+template <typename HalfConverter, typename T>
+bool sameAsConversion(long long lowest, long long highest) {
+    bool same = true;
+    for (long long raw = lowest; raw <= highest; ++raw) {
+        const T value = static_cast<T>(raw);
+        same = same && HalfConverter::isConvertible(value)
+            == static_cast<bool>(HalfConverter::convertOpt(value));
+    }
+    return same;
+}
+
+// Whether each kernel finds an invalid value put at different positions of
+// an array of valid values.
+template <typename SUT, bool toExternal, typename T>
+bool findsFirstInvalid(const std::vector<T>& valid, T invalid) {
+    using HalfConverter = lguim::priv::OneDirectionConverter<toExternal, SUT>;
+    const Isa best = lguim::priv::detectIsa();
+    const Isa isas[] = { Isa::Scalar, Isa::Sse42, Isa::Avx2, Isa::Avx512Vbmi };
+    const std::size_t positions[] = {
+        0, 1, 7, 8, 15, 16, 31, 32, 63, 64, 100, 298, 299, 300,
+    };
+    bool found = true;
+
+    for (std::size_t position : positions) {
+        std::vector<T> values;
+        for (std::size_t i = 0; i < 300; ++i) {
+            values.push_back(valid[(i * 7) % valid.size()]);
+        }
+        if (position < values.size()) {
+            values[position] = invalid;
+        }
+        if (position + 5 < values.size()) {
+            values[position + 5] = invalid;
+        }
+
+        for (Isa isa : isas) {
+            found = found && (isa > best
+                || Validation<SUT, toExternal>::firstInvalidWith(
+                    isa, values.data(), values.size()) == position);
+        }
+        found = found && HalfConverter::firstInvalid(
+            values.data(), values.size()) == position;
+    }
+
+    return found;
+}
+
+START_TEST(Validate)
+    // Kernels available for each mapping
+    ASSERT(Validation<Small, true>::Kernels::supports(Isa::Sse42));
+    ASSERT(Validation<Small, false>::Kernels::supports(Isa::Sse42));
+    ASSERT(!Validation<Bytes60, true>::Kernels::supports(Isa::Avx2));
+    ASSERT(Validation<Bytes60, true>::Kernels::supports(Isa::Avx512Vbmi));
+    ASSERT(Validation<Bytes60, false>::Kernels::supports(Isa::Avx512Vbmi));
+    ASSERT(Validation<Mask16, true>::Kernels::supports(Isa::Avx2));
+    ASSERT(!Validation<Mask16, true>::Kernels::supports(Isa::Sse42));
+    ASSERT(!Validation<Sparse32, true>::Kernels::supports(Isa::Avx2));
+    ASSERT(Validation<Mask16, true>::Kernels::gather);
+    ASSERT(!lguim::priv::Convertibility<
+        lguim::engine::Auto, true, Sparse32>::masked);
+
+    // Single values
+    ASSERT(Small::isConvertibleExternal(B::B3));
+    ASSERT(!Small::isConvertibleExternal(B::B4));
+    ASSERT(Bytes60::isConvertibleInternal(G::G0));
+    ASSERT(!Bytes60::isConvertibleInternal(G::G4));
+    ASSERT(Mask16::isConvertibleInternal(J::J29));
+    ASSERT(!Mask16::isConvertibleInternal(J::J6));
+    ASSERT(!Mask16::isConvertibleInternal(static_cast<J>(-999)));
+    ASSERT(Sparse32::isConvertibleInternal(L::L4));
+    ASSERT(!Sparse32::isConvertibleInternal(static_cast<L>(2)));
+
+    ASSERT((sameAsConversion<Small::HalfConverter<TB>, A>(0, 255)));
+    ASSERT((sameAsConversion<Small::HalfConverter<TA>, B>(-128, 127)));
+    ASSERT((sameAsConversion<
+        lguim::priv::OneDirectionConverter<true, Bytes60>, G>(0, 255)));
+    ASSERT((sameAsConversion<
+        lguim::priv::OneDirectionConverter<false, Bytes60>, H>(0, 255)));
+    ASSERT((sameAsConversion<
+        lguim::priv::OneDirectionConverter<true, Mask16>, J>(-1200, 2000)));
+    ASSERT((sameAsConversion<
+        lguim::priv::OneDirectionConverter<true, Sparse32>, L>(-10, 10)));
+
+    // Arrays
+    ASSERT((findsFirstInvalid<Small, true>(
+        std::vector<A> { A::A1, A::A2, A::A3 }, A::A4)));
+    ASSERT((findsFirstInvalid<Small, false>(
+        std::vector<B> { B::B1, B::B2, B::B3 }, static_cast<B>(-6))));
+    ASSERT((findsFirstInvalid<Bytes60, true>(
+        std::vector<G> { G::G0, G::G13, G::G38, G::G21 }, G::G24)));
+    ASSERT((findsFirstInvalid<Bytes60, false>(
+        std::vector<H> { H::H1, H::H31, H::H39, H::H2 }, H::H10)));
+    ASSERT((findsFirstInvalid<Mask16, true>(
+        std::vector<J> { J::J0, J::J29, J::J17, J::J1 }, J::J13)));
+    ASSERT((findsFirstInvalid<Mask16, true>(
+        std::vector<J> { J::J0, J::J29, J::J17 }, static_cast<J>(-1001))));
+    ASSERT((findsFirstInvalid<Sparse32, true>(
+        std::vector<L> { L::L1, L::L2, L::L3, L::L4 }, static_cast<L>(0))));
+
+    COMPARE_EQ(Small::firstInvalid<TB>(nullptr, 0), 0u);
+END_TEST
@@ -0,0 +1,82 @@
+#include "assertions.h"
+#include "lguim/secureenumconverter.h"
+
+enum class A { A1 = 40, A2 = -3, A3 = 7, A4 = 12 }; struct TA;
+enum class B { B1 = 5, B2 = 900, B3 = 1, B4 = 0 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_PROJ_I2E(A::A3, B::B1) \
+    SEC_PROJ_E2I(A::A2, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+enum class C { C1, C2, C3 };
+enum class D { D1, D2, D3 };
+using InlineSUT = lguim::SecureEnumConverter<C, D>;
+
+#define SEC_TYPE InlineSUT
+#define SEC_INLINE
+#define SEC_MAPPING \
+    SEC_EQUIV(C::C2, D::D1) \
+    SEC_EQUIV(C::C1, D::D3) \
+    SEC_ORPHAN_INT(C::C3) \
+    SEC_ORPHAN_EXT(D::D2)
+#include "lguim/secureenumconverter.inc"
+
+// Inline spans are constant expressions.
+static_assert(InlineSUT::convertibleInternalSpan().size() == 2, "C1, C2");
+static_assert(InlineSUT::convertibleInternalSpan()[0] == C::C1, "C1");
+static_assert(InlineSUT::convertibleInternalSpan().contains(C::C2), "C2");
+static_assert(!InlineSUT::convertibleInternalSpan().contains(C::C3), "C3");
+static_assert(InlineSUT::convertibleExternalSpan()[1] == D::D3, "D3");
+
+template <typename T>
+std::vector<T> toVector(lguim::ValueSpan<T> span) {
+    return std::vector<T>(span.begin(), span.end());
+}
+
+START_TEST(ValueSpan)
+    // Sorted by underlying value, without duplicates.
+    std::vector<A> expectedInternalValues { A::A2, A::A3, A::A1 };
+    COMPARE_EQ(toVector(SUT::convertibleInternalSpan()),
+               expectedInternalValues);
+
+    std::vector<B> expectedExternalValues { B::B3, B::B1, B::B2 };
+    COMPARE_EQ(toVector(SUT::convertibleExternalSpan()),
+               expectedExternalValues);
+
+    // Same array for every call.
+    COMPARE_EQ(SUT::convertibleInternalSpan().data(),
+               SUT::convertibleInternalSpan().data());
+
+    // contains
+    ASSERT(SUT::convertibleInternalSpan().contains(A::A1));
+    ASSERT(SUT::convertibleInternalSpan().contains(A::A2));
+    ASSERT(SUT::convertibleInternalSpan().contains(A::A3));
+    ASSERT(!SUT::convertibleInternalSpan().contains(A::A4));
+    ASSERT(SUT::convertibleExternalSpan().contains(B::B3));
+    ASSERT(!SUT::convertibleExternalSpan().contains(B::B4));
+
+    // Same values as the sets.
+    COMPARE_EQ(SUT::convertibleInternalSpan().toSet(),
+               SUT::convertibleInternalValues());
+    COMPARE_EQ(SUT::convertibleExternalSpan().toSet(),
+               SUT::convertibleExternalValues());
+
+    // Tagged and half converters.
+    COMPARE_EQ(toVector(SUT::convertibleSpan<TA>()), expectedInternalValues);
+    COMPARE_EQ(toVector(SUT::convertibleSpan<TB>()), expectedExternalValues);
+    COMPARE_EQ(toVector(SUT::HalfConverter<TA>::convertibleSpan()),
+               expectedInternalValues);
+    COMPARE_EQ(toVector(SUT::ReversedHalfConverter<TA>::convertibleSpan()),
+               expectedExternalValues);
+
+    // The sets are not copied.
+    COMPARE_EQ(&SUT::convertibleValues<TA>(),
+               &SUT::convertibleInternalValues());
+END_TEST
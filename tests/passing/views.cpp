@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cstdint>
+#include <forward_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "assertions.h"
+#include "lguim/convertview.h"
+
+enum class A : std::uint8_t { A1, A2, A3, A4 }; struct TA;
+enum class B : std::int32_t { B1 = 10, B2 = 200, B3 = 3000, B4 = 4 }; struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B2) \
+    SEC_EQUIV(A::A2, B::B1) \
+    SEC_EQUIV(A::A3, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+START_TEST(Views)
+    const std::vector<A> internal { A::A1, A::A4, A::A3, A::A2, A::A4 };
+
+    // Lazy conversion, keeping random access
+    auto view = lguim::views::convert<SUT, TB>(internal);
+    using Iterator = decltype(view.begin());
+    ASSERT(std::is_same<
+        std::iterator_traits<Iterator>::iterator_category,
+        std::random_access_iterator_tag>::value);
+    COMPARE_EQ(view.size(), 5u);
+    COMPARE_EQ(view.begin()[0], B::B2);
+    COMPARE_EQ(*(view.begin() + 2), B::B3);
+    COMPARE_EQ(*(view.end() - 2), B::B1);
+    COMPARE_EQ(view.end() - view.begin(), 5);
+    ASSERT(view.begin() < view.end());
+    THROWS(std::invalid_argument, *(view.begin() + 1));
+
+    // Batch conversion to a contiguous output
+    std::vector<B> external(view.size(), B::B4);
+    lguim::BatchResult result = view.convertTo(external.data());
+    COMPARE_EQ(result.invalidCount, 2u);
+    COMPARE_EQ(result.firstInvalid, 1u);
+    ASSERT(external == std::vector<B> { B::B2, B::B4, B::B3, B::B1, B::B4 });
+
+    // Pipe, other direction, owned range
+    auto back = std::vector<B> { B::B1, B::B2 }
+        | lguim::views::convert<SUT, TA>();
+    ASSERT(std::vector<A>(back.begin(), back.end())
+        == std::vector<A> { A::A2, A::A1 });
+
+    // Orphans skipped
+    auto convertible = internal | lguim::views::convertible<SUT, TB>();
+    ASSERT(std::vector<B>(convertible.begin(), convertible.end())
+        == std::vector<B> { B::B2, B::B3, B::B1 });
+
+    std::vector<B> compacted(internal.size(), B::B4);
+    COMPARE_EQ(convertible.convertTo(compacted.data()), 3u);
+    ASSERT(compacted
+        == std::vector<B> { B::B2, B::B3, B::B1, B::B4, B::B4 });
+
+    const std::vector<A> orphans { A::A4, A::A4 };
+    ASSERT(lguim::views::convertible<SUT, TB>(orphans).empty());
+
+    // Ranges which are not contiguous
+    const std::forward_list<B> list { B::B3, B::B4, B::B1 };
+    auto fromList = lguim::views::convert<SUT, lguim::side::Internal>(list);
+    ASSERT(std::is_same<
+        std::iterator_traits<decltype(fromList.begin())>::iterator_category,
+        std::forward_iterator_tag>::value);
+    COMPARE_EQ(fromList.size(), 3u);
+
+    std::vector<A> fromListOutput(3, A::A4);
+    result = fromList.convertTo(fromListOutput.data());
+    COMPARE_EQ(result.invalidCount, 1u);
+    COMPARE_EQ(result.firstInvalid, 1u);
+    ASSERT(fromListOutput == std::vector<A> { A::A3, A::A4, A::A2 });
+
+    std::vector<A> compactedList(3, A::A4);
+    const std::size_t written = lguim::views::convertible<SUT, TA>(list)
+        .convertTo(compactedList.data());
+    COMPARE_EQ(written, 2u);
+    ASSERT(compactedList == std::vector<A> { A::A3, A::A2, A::A4 });
+
+    // Arrays
+    const A array[] = { A::A3, A::A3, A::A4 };
+    B arrayOutput[3] = { B::B4, B::B4, B::B4 };
+    result = lguim::views::convert<SUT, TB>(array).convertTo(arrayOutput);
+    COMPARE_EQ(result.invalidCount, 1u);
+    COMPARE_EQ(result.firstInvalid, 2u);
+    COMPARE_EQ(arrayOutput[1], B::B3);
+    COMPARE_EQ(std::count(
+        view.begin(), view.begin() + 1, B::B2), 1);
+END_TEST
@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <string>
+
+#include "assertions.h"
+#include "lguim/enumvisit.h"
+
+enum class A : std::uint8_t { A1, A2, A2_old, A3, A4 }; struct TA;
+enum class B : std::int32_t { B1 = 3000, B2 = -200, B3 = 10, B4 = 4 };
+struct TB;
+using SUT = lguim::TaggedEnumConverter<TA, A, TB, B>;
+
+#define SEC_TYPE SUT
+#define SEC_MAPPING \
+    SEC_EQUIV(A::A1, B::B1) \
+    SEC_EQUIV(A::A2, B::B2) \
+    SEC_PROJ_I2E(A::A2_old, B::B2) \
+    SEC_EQUIV(A::A3, B::B3) \
+    SEC_ORPHAN_INT(A::A4) \
+    SEC_ORPHAN_EXT(B::B4)
+#include "lguim/secureenumconverter.inc"
+
+// No overload for `B::B4`, which nothing converts to
+struct ExternalHandler {
+    int calls = 0;
+
+    std::string operator()(lguim::EnumConstant<B, B::B1>) {
+        ++calls;
+        return "B1";
+    }
+
+    std::string operator()(lguim::EnumConstant<B, B::B2>) {
+        ++calls;
+        return "B2";
+    }
+
+    std::string operator()(lguim::EnumConstant<B, B::B3>) {
+        ++calls;
+        return "B3";
+    }
+};
+
+int orphanValue(A) { return -1; }
+int oneValue() { return 1; }
+int twoValue() { return 2; }
+
+START_TEST(Visit)
+    ExternalHandler handler;
+    auto orphan = [](A a) {
+        return "orphan " + std::to_string(static_cast<int>(a));
+    };
+
+    auto visitB = [&](A a) {
+        return lguim::visit<SUT, TB>(a, handler, orphan);
+    };
+
+    COMPARE_EQ(visitB(A::A1), "B1");
+    COMPARE_EQ(visitB(A::A2), "B2");
+    COMPARE_EQ(visitB(A::A2_old), "B2");
+    COMPARE_EQ(visitB(A::A3), "B3");
+    COMPARE_EQ(visitB(A::A4), "orphan 4");
+    COMPARE_EQ(visitB(static_cast<A>(42)), "orphan 42");
+    COMPARE_EQ(handler.calls, 4);
+
+    // Generic handler, other direction
+    auto generic = [](A a) { return static_cast<int>(a); };
+    auto externalOrphan = [](B) { return -1; };
+    COMPARE_EQ(
+        (lguim::visit<SUT, TA>(B::B3, generic, externalOrphan)), 3);
+    COMPARE_EQ(
+        (lguim::visit<SUT, TA>(B::B4, generic, externalOrphan)), -1);
+
+    // Values only reached by the projection need no overload
+    struct InternalHandler {
+        int operator()(lguim::EnumConstant<A, A::A1>) const { return 1; }
+        int operator()(lguim::EnumConstant<A, A::A2>) const { return 2; }
+        int operator()(lguim::EnumConstant<A, A::A3>) const { return 3; }
+    };
+    COMPARE_EQ(
+        (lguim::visit<SUT, lguim::side::Internal>(
+            B::B2, InternalHandler(), externalOrphan)),
+        2);
+
+    // Table of functions
+    lguim::EnumMap<SUT, TB, int (*)()> table(&oneValue);
+    table[B::B3] = &twoValue;
+    COMPARE_EQ((lguim::visitTable<SUT, TB>(A::A1, table, orphanValue)), 1);
+    COMPARE_EQ((lguim::visitTable<SUT, TB>(A::A3, table, orphanValue)), 2);
+    COMPARE_EQ((lguim::visitTable<SUT, TB>(A::A4, table, orphanValue)), -1);
+END_TEST